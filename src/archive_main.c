@@ -0,0 +1,238 @@
+#include "attack.h"
+#include "game_archive.h"
+#include "thread.h"
+#include "timer.h"
+#include "zobrist.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define FIND_MAX_IDS 64 ///< Numéros affichés au plus par `find`
+
+static void print_usage(const char *program) {
+  fprintf(stderr,
+          "Usage : %s pack PARTIES ARCHIVE\n"
+          "        %s show ARCHIVE N\n"
+          "        %s find ARCHIVE CLÉ\n"
+          "        %s stats ARCHIVE [--threads N]\n"
+          "PARTIES : parties au format de game_record.h (selfplay --records)\n"
+          "CLÉ : clé de Zobrist de la position finale, en hexadécimal\n",
+          program, program, program, program);
+}
+
+static bool is_space(const char c) {
+  return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
+
+static int pack(const char *input, const char *output) {
+  MappedFile mapped;
+  if (!map_file(input, &mapped)) {
+    perror("Impossible de lire le fichier de parties");
+    return 1;
+  }
+  ArchiveWriter writer;
+  if (!open_archive_writer(&writer, output)) {
+    perror("Impossible de créer l'archive");
+    unmap_file(&mapped);
+    return 1;
+  }
+
+  const char *text = (const char *)mapped.data;
+  size_t at = 0;
+  bool success = true;
+  for (;;) {
+    while (at < mapped.size && is_space(text[at]))
+      at++;
+    if (at == mapped.size)
+      break;
+
+    GameRecord record;
+    size_t offset;
+    const DeserializeResult result =
+        parse_game_record(text + at, mapped.size - at, &record, &offset);
+    if (result != DESERIALIZE_SUCCESS) {
+      fprintf(stderr, "Partie %u illisible (octet %zu) : %s\n",
+              writer.count + 1, at + offset,
+              deserialize_error_message(result));
+      success = false;
+      break;
+    }
+    at += offset;
+
+    success = archive_game(&writer, &record);
+    free_game_record(&record);
+    if (!success) {
+      perror("Impossible d'écrire l'archive");
+      break;
+    }
+  }
+
+  const uint32_t count = writer.count;
+  if (!close_archive_writer(&writer) && success) {
+    perror("Impossible d'écrire l'archive");
+    success = false;
+  }
+  unmap_file(&mapped);
+  if (success)
+    printf("%u parties archivées\n", count);
+  return success ? 0 : 1;
+}
+
+static int show(const GameArchive *archive, const char *value) {
+  const unsigned long id = strtoul(value, NULL, 10);
+  if (id >= archive->count) {
+    fprintf(stderr, "Pas de partie %s : l'archive en contient %u\n", value,
+            archive->count);
+    return 1;
+  }
+
+  GameRecord record;
+  const DeserializeResult result =
+      read_archived_game(archive, (uint32_t)id, &record);
+  if (result != DESERIALIZE_SUCCESS) {
+    fprintf(stderr, "Partie %s illisible : %s\n", value,
+            deserialize_error_message(result));
+    return 1;
+  }
+
+  const size_t size = format_game_record(&record, NULL, 0);
+  char *text = malloc(size + 1);
+  if (text == NULL) {
+    perror("Failed to allocate memory for a game record");
+    exit(EXIT_FAILURE);
+  }
+  format_game_record(&record, text, size + 1);
+  fputs(text, stdout);
+  free(text);
+
+  GameState state;
+  replay_game_record(&record, record.count, &state);
+  printf("Clé finale : %016llx\n", (unsigned long long)state.hash);
+  free_game_state(&state);
+  free_game_record(&record);
+  return 0;
+}
+
+static int find(const GameArchive *archive, const char *value) {
+  uint32_t ids[FIND_MAX_IDS];
+  const uint32_t found = find_archived_games(
+      archive, strtoull(value, NULL, 16), ids, FIND_MAX_IDS);
+
+  printf("%u parties :", found);
+  for (uint32_t i = 0; i < found && i < FIND_MAX_IDS; ++i)
+    printf(" %u", ids[i]);
+  printf(found > FIND_MAX_IDS ? " ...\n" : "\n");
+  return 0;
+}
+
+// Totaux d'un thread de `stats`, additionnés à la fin
+typedef struct {
+  uint64_t games;
+  uint64_t plies;
+  uint64_t results[4]; // Indexé par `RecordResult`
+} ArchiveStats;
+
+static void count_game(void *arg, const uint32_t worker, const uint32_t id,
+                       const GameRecord *record) {
+  (void)id;
+  ArchiveStats *stats = &((ArchiveStats *)arg)[worker];
+  stats->games++;
+  stats->plies += record->count;
+  stats->results[record->result]++;
+}
+
+static int stats(const GameArchive *archive, const uint32_t threads) {
+  ArchiveStats *totals = calloc(threads, sizeof(ArchiveStats));
+  if (totals == NULL) {
+    perror("Failed to allocate memory for the statistics");
+    exit(EXIT_FAILURE);
+  }
+
+  const uint64_t start_ms = now_ms();
+  const DeserializeResult result =
+      scan_game_archive(archive, threads, count_game, totals);
+  const uint64_t elapsed_ms = now_ms() - start_ms;
+
+  for (uint32_t i = 1; i < threads; ++i) {
+    totals[0].games += totals[i].games;
+    totals[0].plies += totals[i].plies;
+    for (int r = 0; r < 4; ++r)
+      totals[0].results[r] += totals[i].results[r];
+  }
+  const ArchiveStats *total = &totals[0];
+  printf("%llu parties, %.1f coups en moyenne\n",
+         (unsigned long long)total->games,
+         total->games ? (double)total->plies / (double)total->games : 0.0);
+  printf("1-0 : %llu, 0-1 : %llu, 1/2-1/2 : %llu, * : %llu\n",
+         (unsigned long long)total->results[RecordWhiteWins],
+         (unsigned long long)total->results[RecordBlackWins],
+         (unsigned long long)total->results[RecordDraw],
+         (unsigned long long)total->results[RecordUnfinished]);
+  printf("Lu en %llu ms sur %u threads\n", (unsigned long long)elapsed_ms,
+         threads);
+  free(totals);
+
+  if (result != DESERIALIZE_SUCCESS) {
+    fprintf(stderr, "Parties illisibles ignorées : %s\n",
+            deserialize_error_message(result));
+    return 1;
+  }
+  return 0;
+}
+
+// Commande connue et nombre d'arguments attendu
+static bool check_arguments(const int argc, char **argv, uint32_t *threads) {
+  *threads = hardware_thread_count();
+  if (argc < 3)
+    return false;
+
+  const char *command = argv[1];
+  if (strcmp(command, "stats") == 0) {
+    if (argc == 3)
+      return true;
+    if (argc != 5 || strcmp(argv[3], "--threads") != 0)
+      return false;
+    *threads = (uint32_t)strtoul(argv[4], NULL, 10);
+    return *threads > 0;
+  }
+  return argc == 4 &&
+         (strcmp(command, "pack") == 0 || strcmp(command, "show") == 0 ||
+          strcmp(command, "find") == 0);
+}
+
+int main(const int argc, char **argv) {
+  uint32_t threads;
+  if (!check_arguments(argc, argv, &threads)) {
+    print_usage(argv[0]);
+    return 1;
+  }
+
+  // Tables partagées : calculées avant de lancer les threads
+  init_attack_tables();
+  init_zobrist_keys();
+
+  const char *command = argv[1];
+  if (strcmp(command, "pack") == 0)
+    return pack(argv[2], argv[3]);
+
+  GameArchive archive;
+  const DeserializeResult result = open_game_archive(argv[2], &archive);
+  if (result != DESERIALIZE_SUCCESS) {
+    if (result == DESERIALIZE_IO_ERROR)
+      perror("Impossible d'ouvrir l'archive");
+    else
+      fprintf(stderr, "Archive illisible : %s\n",
+              deserialize_error_message(result));
+    return 1;
+  }
+
+  int status;
+  if (strcmp(command, "show") == 0)
+    status = show(&archive, argv[3]);
+  else if (strcmp(command, "find") == 0)
+    status = find(&archive, argv[3]);
+  else
+    status = stats(&archive, threads);
+  close_game_archive(&archive);
+  return status;
+}
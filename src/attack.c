@@ -0,0 +1,180 @@
+#include "attack.h"
+
+BitBoard king_attack_table[ATTACK_DIM_COUNT][ATTACK_SQUARES];
+BitBoard knight_attack_table[ATTACK_DIM_COUNT][ATTACK_SQUARES];
+BitBoard pawn_attack_table[2][ATTACK_DIM_COUNT][ATTACK_SQUARES];
+
+// Attaques le long d'une ligne de 12 cases : [position][occupation]
+static uint16_t line_attack_table[BITBOARD_MAX_DIM][1 << BITBOARD_MAX_DIM];
+// Diagonales (dx = dy) et anti-diagonales (dx = -dy) passant par chaque case
+static BitBoard diagonal_mask[ATTACK_SQUARES];
+static BitBoard anti_diagonal_mask[ATTACK_SQUARES];
+// Cases appartenant au plateau, pour chaque dimension
+static BitBoard inside_mask[ATTACK_DIM_COUNT];
+
+static bool attack_tables_ready = false;
+
+// Un bit par ligne d'un mot : bits 0, 16, 32 et 48
+#define ROW_LANES 0x0001000100010001ULL
+// Rassemble les bits 0, 16, 32 et 48 dans les bits 60 à 63 (sans retenue)
+#define COLUMN_GATHER_MAGIC                                                    \
+  ((1ULL << 60) | (1ULL << 45) | (1ULL << 30) | (1ULL << 15))
+// Opération inverse : répartit les bits 0 à 3 sur les bits 0, 16, 32 et 48
+#define COLUMN_SPREAD_MAGIC                                                    \
+  ((1ULL << 45) | (1ULL << 30) | (1ULL << 15) | 1ULL)
+
+// Construit le masque des cases (x + dx, y + dy) qui restent sur le plateau
+static BitBoard offsets_mask(const uint8_t dim, const uint8_t x,
+                             const uint8_t y, const int offsets[][2],
+                             const int count) {
+  BitBoard mask = bb_empty();
+
+  for (int i = 0; i < count; ++i) {
+    const int nx = x + offsets[i][0];
+    const int ny = y + offsets[i][1];
+    if (nx >= 0 && ny >= 0 && nx < dim && ny < dim)
+      bb_set(&mask, (uint8_t)nx, (uint8_t)ny);
+  }
+
+  return mask;
+}
+
+// Attaques depuis `pos` sur une ligne de 12 cases, bloquées (inclus) par `occ`
+static uint16_t slide_line(const int pos, const unsigned occ) {
+  uint16_t attacks = 0;
+
+  for (int i = pos + 1; i < BITBOARD_MAX_DIM; ++i) {
+    attacks |= (uint16_t)(1u << i);
+    if (occ & (1u << i))
+      break;
+  }
+  for (int i = pos - 1; i >= 0; --i) {
+    attacks |= (uint16_t)(1u << i);
+    if (occ & (1u << i))
+      break;
+  }
+
+  return attacks;
+}
+
+// Masque des cases (x + k * dx, y + k * dy) sur une grille 12x12
+static BitBoard line_mask(const uint8_t x, const uint8_t y, const int dx,
+                          const int dy) {
+  BitBoard mask = bb_square(x, y);
+
+  for (int sign = -1; sign <= 1; sign += 2) {
+    int cx = x + sign * dx;
+    int cy = y + sign * dy;
+    while (cx >= 0 && cy >= 0 && cx < BITBOARD_MAX_DIM &&
+           cy < BITBOARD_MAX_DIM) {
+      bb_set(&mask, (uint8_t)cx, (uint8_t)cy);
+      cx += sign * dx;
+      cy += sign * dy;
+    }
+  }
+
+  return mask;
+}
+
+// Attaques le long d'une diagonale : les lignes du masque sont repliées en
+// une seule, indexée par colonne, puis le résultat est recopié sur toutes les
+// lignes et recoupé avec la diagonale.
+static BitBoard diagonal_attacks(const BitBoard occupied, const BitBoard line,
+                                 const uint8_t x) {
+  const BitBoard occ = bb_and(occupied, line);
+  uint64_t folded = occ.w[0] | occ.w[1] | occ.w[2];
+  folded |= folded >> 32;
+  folded |= folded >> 16;
+
+  const unsigned index = (unsigned)(folded & 0xFFF) & ~(1u << x);
+  const uint64_t spread = line_attack_table[x][index] * ROW_LANES;
+
+  return (BitBoard){{spread & line.w[0], spread & line.w[1],
+                     spread & line.w[2]}};
+}
+
+BitBoard rook_attacks(const uint8_t dim, const BitBoard occupied,
+                      const uint8_t x, const uint8_t y) {
+  BitBoard attacks = bb_empty();
+
+  // Ligne : 12 bits contigus dans un seul mot
+  const int word = y >> 2;
+  const int shift = (y & 3) * BITBOARD_ROW_STRIDE;
+  const unsigned row = (unsigned)(occupied.w[word] >> shift) & 0xFFF;
+  attacks.w[word] =
+      (uint64_t)line_attack_table[x][row & ~(1u << x)] << shift;
+
+  // Colonne : 4 bits par mot, rassemblés par multiplication
+  unsigned column = 0;
+  for (int k = 0; k < BITBOARD_WORDS; ++k) {
+    const uint64_t lanes = (occupied.w[k] >> x) & ROW_LANES;
+    column |= (unsigned)((lanes * COLUMN_GATHER_MAGIC) >> 60) << (4 * k);
+  }
+
+  const unsigned reached = line_attack_table[y][column & ~(1u << y)];
+  for (int k = 0; k < BITBOARD_WORDS; ++k) {
+    const uint64_t nibble = (reached >> (4 * k)) & 0xF;
+    attacks.w[k] |= ((nibble * COLUMN_SPREAD_MAGIC) & ROW_LANES) << x;
+  }
+
+  return bb_and(attacks, inside_mask[dim - ATTACK_MIN_DIM]);
+}
+
+BitBoard bishop_attacks(const uint8_t dim, const BitBoard occupied,
+                        const uint8_t x, const uint8_t y) {
+  const int sq = y * BITBOARD_MAX_DIM + x;
+  const BitBoard attacks =
+      bb_or(diagonal_attacks(occupied, diagonal_mask[sq], x),
+            diagonal_attacks(occupied, anti_diagonal_mask[sq], x));
+
+  return bb_and(attacks, inside_mask[dim - ATTACK_MIN_DIM]);
+}
+
+BitBoard queen_attacks(const uint8_t dim, const BitBoard occupied,
+                       const uint8_t x, const uint8_t y) {
+  return bb_or(rook_attacks(dim, occupied, x, y),
+               bishop_attacks(dim, occupied, x, y));
+}
+
+void init_attack_tables(void) {
+  if (attack_tables_ready)
+    return;
+
+  const int king_offsets[8][2] = {{-1, 0},  {1, 0},  {0, -1}, {0, 1},
+                                  {-1, -1}, {-1, 1}, {1, -1}, {1, 1}};
+  const int knight_jumps[8][2] = {{2, 1},   {1, 2},   {-1, 2}, {-2, 1},
+                                  {-2, -1}, {-1, -2}, {1, -2}, {2, -1}};
+  // Les pions de l'utilisateur avancent vers le haut (y décroissant)
+  const int user_pawn[1][2] = {{0, -1}};
+  const int opponent_pawn[1][2] = {{0, 1}};
+
+  for (int pos = 0; pos < BITBOARD_MAX_DIM; ++pos) {
+    for (unsigned occ = 0; occ < (1u << BITBOARD_MAX_DIM); ++occ)
+      line_attack_table[pos][occ] = slide_line(pos, occ);
+  }
+
+  for (uint8_t y = 0; y < BITBOARD_MAX_DIM; ++y) {
+    for (uint8_t x = 0; x < BITBOARD_MAX_DIM; ++x) {
+      diagonal_mask[y * BITBOARD_MAX_DIM + x] = line_mask(x, y, 1, 1);
+      anti_diagonal_mask[y * BITBOARD_MAX_DIM + x] = line_mask(x, y, 1, -1);
+    }
+  }
+
+  for (uint8_t dim = ATTACK_MIN_DIM; dim <= BITBOARD_MAX_DIM; ++dim) {
+    const int d = dim - ATTACK_MIN_DIM;
+    inside_mask[d] = bb_board_mask(dim);
+
+    for (uint8_t y = 0; y < dim; ++y) {
+      for (uint8_t x = 0; x < dim; ++x) {
+        const int sq = y * BITBOARD_MAX_DIM + x;
+        king_attack_table[d][sq] = offsets_mask(dim, x, y, king_offsets, 8);
+        knight_attack_table[d][sq] = offsets_mask(dim, x, y, knight_jumps, 8);
+        pawn_attack_table[User][d][sq] = offsets_mask(dim, x, y, user_pawn, 1);
+        pawn_attack_table[Opponent][d][sq] =
+            offsets_mask(dim, x, y, opponent_pawn, 1);
+      }
+    }
+  }
+
+  attack_tables_ready = true;
+}
@@ -0,0 +1,86 @@
+#ifndef ATTACK_H
+#define ATTACK_H
+#include "bitboard.h"
+#include "player.h"
+
+#define ATTACK_MIN_DIM 6 ///< Plus petite dimension de plateau supportée
+#define ATTACK_DIM_COUNT (BITBOARD_MAX_DIM - ATTACK_MIN_DIM + 1)
+#define ATTACK_SQUARES (BITBOARD_MAX_DIM * BITBOARD_MAX_DIM)
+
+/**
+ * @brief Tables des cases atteintes par les pièces à déplacement fixe.
+ *
+ * Indexées par `[dim - 6][y * 12 + x]` (et par joueur pour les pions), elles
+ * contiennent déjà le découpage aux bords du plateau de cette dimension.
+ * Elles sont remplies une fois par `init_attack_tables`.
+ */
+extern BitBoard king_attack_table[ATTACK_DIM_COUNT][ATTACK_SQUARES];
+extern BitBoard knight_attack_table[ATTACK_DIM_COUNT][ATTACK_SQUARES];
+extern BitBoard pawn_attack_table[2][ATTACK_DIM_COUNT][ATTACK_SQUARES];
+
+/**
+ * @brief Calcule les tables d'attaque pour toutes les dimensions (6 à 12).
+ *
+ * Doit être appelée avant toute capture. Les appels suivants ne font rien ;
+ * l'appeler au démarrage du programme, avant de créer des threads.
+ */
+void init_attack_tables(void);
+
+/**
+ * @brief Cases atteintes par une tour placée en (x, y).
+ *
+ * Chaque direction s'arrête sur la première case occupée, qui est incluse dans
+ * le résultat. Le calcul n'effectue aucune boucle sur les rayons : la ligne et
+ * la colonne de la case sont extraites de `occupied` (décalage pour la ligne,
+ * multiplication « magique » pour la colonne) puis résolues par une table.
+ *
+ * @param dim La dimension du plateau.
+ * @param occupied Le masque des cases occupées.
+ * @param x Colonne de la tour.
+ * @param y Ligne de la tour.
+ * @return BitBoard Les cases atteintes, limitées au plateau.
+ */
+BitBoard rook_attacks(uint8_t dim, BitBoard occupied, uint8_t x, uint8_t y);
+
+/**
+ * @brief Cases atteintes par un fou placé en (x, y).
+ *
+ * Même convention que `rook_attacks`. Les deux diagonales sont extraites en
+ * repliant les lignes du masque les unes sur les autres : une diagonale
+ * possède au plus une case par colonne.
+ *
+ * @param dim La dimension du plateau.
+ * @param occupied Le masque des cases occupées.
+ * @param x Colonne du fou.
+ * @param y Ligne du fou.
+ * @return BitBoard Les cases atteintes, limitées au plateau.
+ */
+BitBoard bishop_attacks(uint8_t dim, BitBoard occupied, uint8_t x, uint8_t y);
+
+/**
+ * @brief Cases atteintes par une reine placée en (x, y).
+ *
+ * @return BitBoard L'union de `rook_attacks` et de `bishop_attacks`.
+ */
+BitBoard queen_attacks(uint8_t dim, BitBoard occupied, uint8_t x, uint8_t y);
+
+/// Cases atteintes par un roi placé en (x, y) sur un plateau dim x dim.
+static inline BitBoard king_attacks(const uint8_t dim, const uint8_t x,
+                                    const uint8_t y) {
+  return king_attack_table[dim - ATTACK_MIN_DIM][y * BITBOARD_MAX_DIM + x];
+}
+
+/// Cases atteintes par un cavalier placé en (x, y) sur un plateau dim x dim.
+static inline BitBoard knight_attacks(const uint8_t dim, const uint8_t x,
+                                      const uint8_t y) {
+  return knight_attack_table[dim - ATTACK_MIN_DIM][y * BITBOARD_MAX_DIM + x];
+}
+
+/// Case atteinte par un pion du joueur `player` placé en (x, y).
+static inline BitBoard pawn_attacks(const Player player, const uint8_t dim,
+                                    const uint8_t x, const uint8_t y) {
+  return pawn_attack_table[player][dim - ATTACK_MIN_DIM]
+                          [y * BITBOARD_MAX_DIM + x];
+}
+
+#endif // ATTACK_H
@@ -0,0 +1,82 @@
+#include "bench.h"
+#include "movegen.h"
+#include "search.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+#define BENCH_SEED 20240601
+#define BENCH_RANDOM_PLIES 6 // Coups aléatoires joués avant la recherche
+
+static const uint8_t bench_dims[] = {6, 8, 10, 12};
+#define BENCH_DIM_COUNT (sizeof(bench_dims) / sizeof(bench_dims[0]))
+
+// Construit la position de test n° `index` ; à libérer avec free_game_state
+static GameState bench_position(const int index) {
+  const GameMode mode = index % 2 == 0 ? Conquest : Connect;
+  const uint8_t dim = bench_dims[(index / 2) % BENCH_DIM_COUNT];
+
+  GameState state = init_game_state_with(mode, dim, User);
+
+  Rng rng = init_rng(BENCH_SEED + (uint64_t)index);
+  for (int ply = 0; ply < BENCH_RANDOM_PLIES; ++ply) {
+    Move move;
+    UndoRecord undo;
+    if (!pick_random_move(&state, &rng, &move))
+      break;
+    make_move(&state, move, &undo);
+  }
+  return state;
+}
+
+void run_benchmark(uint32_t max_threads, const uint32_t time_ms) {
+  const int position_count = 2 * (int)BENCH_DIM_COUNT;
+  if (max_threads == 0)
+    max_threads = 1;
+
+  TranspositionTable tt = init_tt(TT_DEFAULT_SIZE_MB);
+  double base_nps = 0.0;
+
+  printf("Banc d'essai : %d positions, %u ms par position.\n", position_count,
+         time_ms);
+  printf("%-8s %-14s %-14s %-10s %s\n", "Threads", "Positions", "Positions/s",
+         "Gain", "Profondeur moy.");
+
+  uint32_t threads = 1;
+  for (;;) {
+    uint64_t nodes = 0;
+    uint64_t elapsed_ms = 0;
+    int depth_sum = 0;
+
+    for (int i = 0; i < position_count; ++i) {
+      GameState state = bench_position(i);
+      clear_tt(&tt);
+
+      const SearchLimits limits = {.max_depth = SEARCH_MAX_PLY - 1,
+                                   .time_limit_ms = time_ms,
+                                   .threads = threads,
+                                   .tt = &tt};
+      const SearchResult result = search_best_move(&state, limits);
+      nodes += result.nodes;
+      elapsed_ms += result.time_ms;
+      depth_sum += result.depth;
+
+      free_game_state(&state);
+    }
+
+    const double nps =
+        elapsed_ms > 0 ? (double)nodes * 1000.0 / (double)elapsed_ms : 0.0;
+    if (threads == 1)
+      base_nps = nps;
+
+    printf("%-8u %-14llu %-14.0f x%-9.2f %.1f\n", threads,
+           (unsigned long long)nodes, nps, base_nps > 0 ? nps / base_nps : 0.0,
+           (double)depth_sum / position_count);
+    fflush(stdout);
+
+    if (threads == max_threads)
+      break;
+    threads = threads * 2 < max_threads ? threads * 2 : max_threads;
+  }
+
+  free_tt(&tt);
+}
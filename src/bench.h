@@ -0,0 +1,23 @@
+#ifndef BENCH_H
+#define BENCH_H
+#include <stdint.h>
+
+#define BENCH_DEFAULT_TIME_MS 500 ///< Temps de recherche par position
+
+/**
+ * @brief Mesure la vitesse de la recherche alpha-beta selon le nombre de
+ * threads.
+ *
+ * Cherche un même ensemble de positions (toutes les dimensions paires, les deux
+ * modes, quelques coups aléatoires joués depuis une graine fixe) avec 1, 2, 4,
+ * ... puis `max_threads` threads, pendant `time_ms` millisecondes chacune. La
+ * table de transposition est vidée avant chaque position. Affiche pour chaque
+ * nombre de threads les positions visitées par seconde et le gain par rapport
+ * à un thread.
+ *
+ * @param max_threads Nombre maximal de threads testé.
+ * @param time_ms Temps de recherche par position, en millisecondes.
+ */
+void run_benchmark(uint32_t max_threads, uint32_t time_ms);
+
+#endif // BENCH_H
@@ -0,0 +1,11 @@
+#include "bitboard.h"
+
+BitBoard bb_board_mask(const uint8_t dim) {
+  BitBoard mask = bb_empty();
+  const uint64_t row = (1ULL << dim) - 1;
+
+  for (uint8_t y = 0; y < dim && y < BITBOARD_MAX_DIM; ++y)
+    mask.w[y >> 2] |= row << ((y & 3) * BITBOARD_ROW_STRIDE);
+
+  return mask;
+}
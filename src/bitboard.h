@@ -0,0 +1,144 @@
+#ifndef BITBOARD_H
+#define BITBOARD_H
+#include <stdbool.h>
+#include <stdint.h>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+#define BITBOARD_MAX_DIM 12 ///< Dimension maximale couverte par un masque
+#define BITBOARD_ROW_STRIDE 16 ///< Nombre de bits réservés à chaque ligne
+#define BITBOARD_WORDS 3       ///< 12 lignes de 16 bits = 3 mots de 64 bits
+
+/**
+ * @brief Masque de 144 bits couvrant un plateau jusqu'à 12x12.
+ *
+ * Chaque ligne `y` occupe 16 bits (dont 12 utiles), de sorte qu'un mot de 64
+ * bits contient exactement 4 lignes et qu'aucune ligne n'est à cheval sur deux
+ * mots. La case (x, y) correspond au bit `(y % 4) * 16 + x` du mot `y / 4`.
+ * Les bits 12 à 15 de chaque ligne restent toujours à zéro.
+ */
+typedef struct {
+  uint64_t w[BITBOARD_WORDS];
+} BitBoard;
+
+static inline int bb_popcount64(const uint64_t v) {
+#if defined(_MSC_VER)
+  return (int)__popcnt64(v);
+#else
+  return __builtin_popcountll(v);
+#endif
+}
+
+static inline int bb_lsb64(const uint64_t v) {
+#if defined(_MSC_VER)
+  unsigned long index;
+  _BitScanForward64(&index, v);
+  return (int)index;
+#else
+  return __builtin_ctzll(v);
+#endif
+}
+
+static inline BitBoard bb_empty(void) { return (BitBoard){{0, 0, 0}}; }
+
+static inline BitBoard bb_square(const uint8_t x, const uint8_t y) {
+  BitBoard bb = bb_empty();
+  bb.w[y >> 2] = 1ULL << (((y & 3) * BITBOARD_ROW_STRIDE) + x);
+  return bb;
+}
+
+static inline bool bb_test(const BitBoard *bb, const uint8_t x,
+                           const uint8_t y) {
+  return (bb->w[y >> 2] >> (((y & 3) * BITBOARD_ROW_STRIDE) + x)) & 1;
+}
+
+static inline void bb_set(BitBoard *bb, const uint8_t x, const uint8_t y) {
+  bb->w[y >> 2] |= 1ULL << (((y & 3) * BITBOARD_ROW_STRIDE) + x);
+}
+
+static inline void bb_clear(BitBoard *bb, const uint8_t x, const uint8_t y) {
+  bb->w[y >> 2] &= ~(1ULL << (((y & 3) * BITBOARD_ROW_STRIDE) + x));
+}
+
+static inline BitBoard bb_and(const BitBoard a, const BitBoard b) {
+  return (BitBoard){{a.w[0] & b.w[0], a.w[1] & b.w[1], a.w[2] & b.w[2]}};
+}
+
+static inline BitBoard bb_or(const BitBoard a, const BitBoard b) {
+  return (BitBoard){{a.w[0] | b.w[0], a.w[1] | b.w[1], a.w[2] | b.w[2]}};
+}
+
+/// Renvoie `a & ~b`.
+static inline BitBoard bb_andnot(const BitBoard a, const BitBoard b) {
+  return (BitBoard){{a.w[0] & ~b.w[0], a.w[1] & ~b.w[1], a.w[2] & ~b.w[2]}};
+}
+
+static inline bool bb_is_empty(const BitBoard bb) {
+  return (bb.w[0] | bb.w[1] | bb.w[2]) == 0;
+}
+
+static inline int bb_popcount(const BitBoard bb) {
+  return bb_popcount64(bb.w[0]) + bb_popcount64(bb.w[1]) +
+         bb_popcount64(bb.w[2]);
+}
+
+/**
+ * @brief Retire la case de plus petit indice du masque et renvoie ses
+ * coordonnées.
+ *
+ * Permet de parcourir uniquement les cases actives d'un masque :
+ * `while (bb_pop_square(&bb, &x, &y)) { ... }`.
+ *
+ * @return bool `false` si le masque était vide.
+ */
+static inline bool bb_pop_square(BitBoard *bb, uint8_t *x, uint8_t *y) {
+  for (int i = 0; i < BITBOARD_WORDS; ++i) {
+    if (bb->w[i]) {
+      const int bit = bb_lsb64(bb->w[i]);
+      bb->w[i] &= bb->w[i] - 1;
+      *y = (uint8_t)(i * 4 + bit / BITBOARD_ROW_STRIDE);
+      *x = (uint8_t)(bit % BITBOARD_ROW_STRIDE);
+      return true;
+    }
+  }
+  return false;
+}
+
+/**
+ * @brief Renvoie les coordonnées de la n-ième case active du masque.
+ *
+ * Les cases sont numérotées dans l'ordre de `bb_pop_square`, à partir de 0.
+ *
+ * @return bool `false` si le masque contient moins de `n + 1` cases.
+ */
+static inline bool bb_nth_square(BitBoard bb, int n, uint8_t *x, uint8_t *y) {
+  for (int i = 0; i < BITBOARD_WORDS; ++i) {
+    const int count = bb_popcount64(bb.w[i]);
+    if (n >= count) {
+      n -= count;
+      continue;
+    }
+
+    uint64_t word = bb.w[i];
+    while (n-- > 0)
+      word &= word - 1;
+
+    const int bit = bb_lsb64(word);
+    *y = (uint8_t)(i * 4 + bit / BITBOARD_ROW_STRIDE);
+    *x = (uint8_t)(bit % BITBOARD_ROW_STRIDE);
+    return true;
+  }
+  return false;
+}
+
+/**
+ * @brief Construit le masque de toutes les cases d'un plateau dim x dim.
+ *
+ * @param dim La dimension du plateau (entre 6 et 12).
+ * @return BitBoard Le masque des cases appartenant au plateau.
+ */
+BitBoard bb_board_mask(uint8_t dim);
+
+#endif // BITBOARD_H
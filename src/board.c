@@ -1,4 +1,5 @@
 #include "board.h"
+#include "attack.h"
 #include <stdio.h>
 #include <stdlib.h>
 
@@ -9,6 +10,9 @@ Board init_board(const uint8_t dim) {
   Board board;
   board.dim = dim;
 
+  // Les captures s'appuient sur les tables d'attaque précalculées
+  init_attack_tables();
+
   // Allocation du tableau de lignes
   board.tiles = malloc(dim * sizeof(Tile *));
   if (board.tiles == NULL) {
@@ -37,15 +41,125 @@ Board init_board(const uint8_t dim) {
     }
   }
 
+  // Plateau vide : seuls les bits des cases du plateau sont définis
+  board.planes = (BoardPlanes){0};
+  board.planes.inside = bb_board_mask(dim);
+
   return board;
 }
 
+Board copy_board(const Board *board) {
+  Board copy = init_board(board->dim);
+
+  for (uint8_t y = 0; y < board->dim; ++y)
+    memcpy(copy.tiles[y], board->tiles[y], board->dim * sizeof(Tile));
+  copy.planes = board->planes;
+
+  return copy;
+}
+
 void free_board(const Board *board) {
   for (uint8_t i = 0; i < board->dim; ++i)
     free(board->tiles[i]); // Libère chaque ligne
   free(board->tiles);      // Puis le tableau de pointeurs
 }
 
+void set_board_tile(Board *board, const uint8_t x, const uint8_t y,
+                    const Tile tile) {
+  BoardPlanes *planes = &board->planes;
+  const Tile previous = board->tiles[y][x];
+
+  if (previous.some) {
+    bb_clear(&planes->occupied, x, y);
+    bb_clear(&planes->by_player[previous.value.player], x, y);
+    bb_clear(&planes->by_kind[previous.value.kind], x, y);
+  }
+
+  if (tile.some) {
+    bb_set(&planes->occupied, x, y);
+    bb_set(&planes->by_player[tile.value.player], x, y);
+    bb_set(&planes->by_kind[tile.value.kind], x, y);
+  }
+
+  board->tiles[y][x] = tile;
+  set_tile_captured_by(board, x, y, tile.captured_by);
+}
+
+void set_tile_captured_by(Board *board, const uint8_t x, const uint8_t y,
+                          const PlayerOption owner) {
+  BoardPlanes *planes = &board->planes;
+
+  bb_clear(&planes->captured_by[User], x, y);
+  bb_clear(&planes->captured_by[Opponent], x, y);
+  if (owner.some)
+    bb_set(&planes->captured_by[owner.player], x, y);
+
+  board->tiles[y][x].captured_by = owner;
+}
+
+void capture_tiles(Board *board, BitBoard mask, const Player owner) {
+  BoardPlanes *planes = &board->planes;
+  const Player other = (owner == User) ? Opponent : User;
+
+  mask = bb_and(mask, planes->inside);
+  planes->captured_by[owner] = bb_or(planes->captured_by[owner], mask);
+  planes->captured_by[other] = bb_andnot(planes->captured_by[other], mask);
+
+  const PlayerOption owner_opt = player_option(owner);
+  uint8_t x, y;
+  while (bb_pop_square(&mask, &x, &y))
+    board->tiles[y][x].captured_by = owner_opt;
+}
+
+void release_tiles(Board *board, BitBoard mask) {
+  BoardPlanes *planes = &board->planes;
+
+  planes->captured_by[User] = bb_andnot(planes->captured_by[User], mask);
+  planes->captured_by[Opponent] =
+      bb_andnot(planes->captured_by[Opponent], mask);
+
+  uint8_t x, y;
+  while (bb_pop_square(&mask, &x, &y))
+    board->tiles[y][x].captured_by = no_player();
+}
+
+bool is_tile_occupied(const Board *board, const uint8_t x, const uint8_t y) {
+  return bb_test(&board->planes.occupied, x, y);
+}
+
+void format_position(const uint8_t dim, const uint8_t x, const uint8_t y,
+                     char *out) {
+  const int row = dim - y;
+  int i = 0;
+
+  out[i++] = (char)('A' + x);
+  if (row >= 10)
+    out[i++] = (char)('0' + row / 10);
+  out[i++] = (char)('0' + row % 10);
+  out[i] = '\0';
+}
+
+bool parse_position(const uint8_t dim, const char *str, uint8_t *x,
+                    uint8_t *y) {
+  const int column = toupper((unsigned char)str[0]) - 'A';
+  if (column < 0 || column >= dim)
+    return false;
+
+  int row = 0;
+  int digits = 0;
+  for (const char *c = str + 1; *c; ++c, ++digits) {
+    if (!isdigit((unsigned char)*c) || digits >= 2)
+      return false;
+    row = row * 10 + (*c - '0');
+  }
+  if (digits == 0 || row < 1 || row > dim)
+    return false;
+
+  *x = (uint8_t)column;
+  *y = (uint8_t)(dim - row);
+  return true;
+}
+
 Tile empty_tile() { return (Tile){.some = false, .captured_by = no_player()}; }
 Tile tile_with_piece(const ChessPiece piece) {
   return (Tile){.some = true, .value = piece, .captured_by = no_player()};
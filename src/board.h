@@ -1,6 +1,7 @@
 #ifndef BOARD_H
 #define BOARD_H
 
+#include "bitboard.h"
 #include "piece.h"
 #include <stdint.h>
 
@@ -16,12 +17,33 @@ typedef struct {
   PlayerOption captured_by;
 } Tile;
 
+/**
+ * @brief Représentation du plateau sous forme de masques de bits.
+ *
+ * Chaque plan est un `BitBoard` de 144 bits. Les plans sont maintenus en
+ * parallèle de la grille `tiles` par les fonctions de modification du plateau
+ * (`set_board_tile`, `set_tile_captured_by`, `capture_tiles`), ce qui permet
+ * d'écrire les captures, les comptages et les vérifications de placement sous
+ * forme d'opérations sur des mots de 64 bits.
+ */
+typedef struct {
+  BitBoard occupied;       ///< Cases contenant une pièce
+  BitBoard by_player[2];   ///< Pièces de chaque joueur (indexé par `Player`)
+  BitBoard by_kind[6];     ///< Pièces de chaque type (indexé par `PieceKind`)
+  BitBoard captured_by[2]; ///< Cases capturées par chaque joueur
+  BitBoard inside;         ///< Cases appartenant au plateau (dim x dim)
+} BoardPlanes;
+
 /**
  * @brief Représente le plateau de jeu sous forme de grille de tuiles.
+ *
+ * La grille `tiles` peut être lue directement, mais toute modification doit
+ * passer par les fonctions de ce module afin que `planes` reste synchronisé.
  */
 typedef struct {
-  Tile **tiles; ///< Tableau 2D de pointeurs vers des tuiles
-  uint8_t dim;  ///< Dimension du plateau (dim x dim)
+  Tile **tiles;       ///< Tableau 2D de pointeurs vers des tuiles
+  uint8_t dim;        ///< Dimension du plateau (dim x dim)
+  BoardPlanes planes; ///< Même contenu que `tiles`, sous forme de bitboards
 } Board;
 
 /**
@@ -34,6 +56,17 @@ typedef struct {
  */
 Board init_board(uint8_t dim);
 
+/**
+ * @brief Crée une copie indépendante d'un plateau.
+ *
+ * La grille est réallouée : la copie peut être modifiée (par exemple par un
+ * autre thread de recherche) sans toucher à l'original.
+ *
+ * @param board Pointeur vers le plateau à copier.
+ * @return Board La copie, à libérer avec `free_board`.
+ */
+Board copy_board(const Board *board);
+
 /**
  * @brief Libère la mémoire allouée dynamiquement pour un plateau.
  *
@@ -41,6 +74,86 @@ Board init_board(uint8_t dim);
  */
 void free_board(const Board *board);
 
+/**
+ * @brief Place une tuile sur le plateau.
+ *
+ * Remplace le contenu de la case (x, y) dans la grille et dans les bitboards.
+ *
+ * @param board Pointeur vers le plateau à modifier.
+ * @param x Colonne de la case.
+ * @param y Ligne de la case.
+ * @param tile La nouvelle tuile.
+ */
+void set_board_tile(Board *board, uint8_t x, uint8_t y, Tile tile);
+
+/**
+ * @brief Modifie le joueur ayant capturé une case, sans toucher à la pièce.
+ *
+ * @param board Pointeur vers le plateau à modifier.
+ * @param x Colonne de la case.
+ * @param y Ligne de la case.
+ * @param owner Le joueur qui capture la case (ou `no_player()`).
+ */
+void set_tile_captured_by(Board *board, uint8_t x, uint8_t y,
+                          PlayerOption owner);
+
+/**
+ * @brief Attribue d'un coup toutes les cases d'un masque à un joueur.
+ *
+ * Les plans `captured_by` sont mis à jour mot par mot ; seule la grille est
+ * parcourue case par case, et uniquement pour les cases du masque.
+ *
+ * @param board Pointeur vers le plateau à modifier.
+ * @param mask Les cases à capturer.
+ * @param owner Le joueur qui capture les cases.
+ */
+void capture_tiles(Board *board, BitBoard mask, Player owner);
+
+/**
+ * @brief Retire le propriétaire de toutes les cases d'un masque.
+ *
+ * Opération inverse de `capture_tiles`, utilisée pour annuler un coup.
+ *
+ * @param board Pointeur vers le plateau à modifier.
+ * @param mask Les cases à libérer.
+ */
+void release_tiles(Board *board, BitBoard mask);
+
+/**
+ * @brief Indique si la case (x, y) contient une pièce.
+ *
+ * @param board Pointeur vers le plateau.
+ * @param x Colonne de la case.
+ * @param y Ligne de la case.
+ * @return bool `true` si une pièce est présente.
+ */
+bool is_tile_occupied(const Board *board, uint8_t x, uint8_t y);
+
+/**
+ * @brief Écrit la notation d'une case, comme saisie par l'utilisateur (ex: A3).
+ *
+ * La colonne est une lettre à partir de `A`, la ligne est numérotée à partir
+ * du bas du plateau (la ligne `y = 0` est la ligne `dim`).
+ *
+ * @param dim La dimension du plateau.
+ * @param x Colonne de la case.
+ * @param y Ligne de la case.
+ * @param out Tampon d'au moins 4 caractères.
+ */
+void format_position(uint8_t dim, uint8_t x, uint8_t y, char *out);
+
+/**
+ * @brief Lit la notation d'une case (ex: A3 ou a3), inverse de
+ * `format_position`.
+ *
+ * @param dim La dimension du plateau.
+ * @param str La notation à lire, sans caractère après le numéro de ligne.
+ * @param x Reçoit la colonne de la case.
+ * @param y Reçoit la ligne de la case.
+ * @return bool `false` si la notation est invalide ou hors du plateau.
+ */
+bool parse_position(uint8_t dim, const char *str, uint8_t *x, uint8_t *y);
+
 /**
  * @brief Crée une tuile vide (sans pièce).
  *
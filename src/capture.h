@@ -2,6 +2,22 @@
 #define CAPTURE_H
 #include "game_state.h"
 
+/**
+ * @brief Calcule les cases capturées par une pièce posée en (x, y).
+ *
+ * Ne modifie pas le plateau : permet d'évaluer un coup avant de le jouer.
+ * Le résultat est le même que la pièce soit déjà posée ou non.
+ *
+ * @param board Pointeur vers le plateau.
+ * @param x Coordonnée x de la case où la pièce est placée.
+ * @param y Coordonnée y de la case où la pièce est placée.
+ * @param piece La pièce placée.
+ * @param capturer Le joueur qui effectue la capture.
+ * @return BitBoard Les cases capturées, case (x, y) comprise.
+ */
+BitBoard conquest_capture_mask(const Board *board, uint8_t x, uint8_t y,
+                               ChessPiece piece, Player capturer);
+
 /**
  * @brief Applique la capture de pièces selon les règles du mode Conquest.
  *
@@ -14,15 +30,31 @@
  * @param piece La pièce qui est placée sur le plateau.
  * @param capturer Le joueur qui effectue la capture.
  */
-void apply_conquest_capture(const GameState *state, uint8_t x, uint8_t y,
+void apply_conquest_capture(GameState *state, uint8_t x, uint8_t y,
                             ChessPiece piece, Player capturer);
 
+/**
+ * @brief Returns the current player's pieces of a given kind that reach a tile.
+ *
+ * Only pieces standing on a tile captured by the current player are taken into
+ * account. The set is computed from the target tile outward (the moves are
+ * symmetric, pawns being looked up backwards), so the cost depends on the
+ * number of rays and not on the size of the board.
+ *
+ * @param state Pointer to the current game state.
+ * @param x The x-coordinate of the target tile.
+ * @param y The y-coordinate of the target tile.
+ * @param kind The type of piece to look for.
+ * @return BitBoard The squares of the matching pieces (empty if none).
+ */
+BitBoard attackers_to_tile(const GameState *state, uint8_t x, uint8_t y, PieceKind kind);
+
 /**
  * @brief Checks if a tile at the given coordinates is captured by a piece of the specified kind.
  *
- * This function iterates through all tiles on the board to determine if any piece of the given kind,
- * captured by the current player, can capture the tile at the specified coordinates `(x, y)`.
- * The logic simulates the capture rules for each piece type.
+ * Determines if any piece of the given kind, captured by the current player, can capture the
+ * tile at the specified coordinates `(x, y)`. This is a non-emptiness test on
+ * `attackers_to_tile`.
  *
  * @param state Pointer to the current game state.
  * @param x The x-coordinate of the target tile.
@@ -32,13 +64,28 @@ void apply_conquest_capture(const GameState *state, uint8_t x, uint8_t y,
  */
 bool is_tile_captured_by_piece_kind(const GameState *state, uint8_t x, uint8_t y, PieceKind kind);
 
+/**
+ * @brief Pose une pièce du joueur actuel et applique ses captures.
+ *
+ * Consomme la pièce dans le compteur du joueur, la place en (x, y) puis
+ * applique `apply_conquest_capture`. En mode Connect, poser le roi vide les
+ * compteurs des deux joueurs, ce qui met fin à la partie. Le tour n'est pas
+ * inversé. Aucune vérification de légalité n'est faite ici.
+ *
+ * @param state Pointeur vers l'état du jeu actuel.
+ * @param kind Le type de pièce posée.
+ * @param x Coordonnée x de la case.
+ * @param y Coordonnée y de la case.
+ */
+void place_piece(GameState *state, PieceKind kind, uint8_t x, uint8_t y);
+
 /// Joue un tour dans le mode "Conquest".
 ///
 /// Ce mode consiste à sélectionner une pièce capturée, choisir une position valide
 /// où la poser, puis appliquer l'effet de capture de cette pièce.
 ///
 /// @param game_state Pointeur vers l’état actuel du jeu.
-void play_conquest_turn(const GameState *game_state);
+void play_conquest_turn(GameState *game_state);
 
 /// Joue un tour dans le mode "Connect".
 ///
@@ -0,0 +1,130 @@
+#include "engine.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define ENGINE_MCTS_CAPACITY (1u << 18)
+
+bool parse_engine_config(const char *spec, EngineConfig *config) {
+  *config = (EngineConfig){.kind = EngineAlphaBeta, .threads = 1};
+
+  const char *options = strchr(spec, ':');
+  const size_t name_length = options ? (size_t)(options - spec) : strlen(spec);
+  if (name_length == 9 && strncmp(spec, "alphabeta", 9) == 0) {
+    config->kind = EngineAlphaBeta;
+    config->depth = 3;
+  } else if (name_length == 4 && strncmp(spec, "mcts", 4) == 0) {
+    config->kind = EngineMcts;
+    config->playouts = 2000;
+  } else {
+    return false;
+  }
+
+  while (options && *options) {
+    options++; // ':' ou ','
+    const char *equal = strchr(options, '=');
+    if (!equal)
+      return false;
+
+    const size_t key_length = (size_t)(equal - options);
+    const char *value = equal + 1;
+    char *end;
+    const unsigned long number = strtoul(value, &end, 10);
+
+    if (key_length == 8 && strncmp(options, "parallel", 8) == 0) {
+      if (strncmp(value, "tree", 4) == 0) {
+        config->parallelism = MctsTreeParallel;
+        end = (char *)value + 4;
+      } else if (strncmp(value, "root", 4) == 0) {
+        config->parallelism = MctsRootParallel;
+        end = (char *)value + 4;
+      } else {
+        return false;
+      }
+    } else if (end == value) {
+      return false;
+    } else if (key_length == 5 && strncmp(options, "depth", 5) == 0) {
+      if (number >= SEARCH_MAX_PLY)
+        return false;
+      config->depth = (uint8_t)number;
+    } else if (key_length == 8 && strncmp(options, "playouts", 8) == 0) {
+      config->playouts = (uint32_t)number;
+    } else if (key_length == 4 && strncmp(options, "time", 4) == 0) {
+      config->time_ms = (uint32_t)number;
+    } else if (key_length == 7 && strncmp(options, "threads", 7) == 0) {
+      config->threads = number > 0 ? (uint32_t)number : 1;
+    } else if (key_length == 4 && strncmp(options, "hash", 4) == 0) {
+      config->hash_mb = (uint32_t)number;
+    } else {
+      return false;
+    }
+
+    if (*end != ',' && *end != '\0')
+      return false;
+    options = end;
+  }
+  return true;
+}
+
+void format_engine_config(const EngineConfig *config, char *out,
+                          const size_t size) {
+  if (config->kind == EngineMcts) {
+    snprintf(out, size, "mcts:playouts=%u,time=%u,threads=%u,parallel=%s",
+             config->playouts, config->time_ms, config->threads,
+             config->parallelism == MctsRootParallel ? "root" : "tree");
+  } else {
+    snprintf(out, size, "alphabeta:depth=%u,time=%u,threads=%u,hash=%u",
+             config->depth, config->time_ms, config->threads,
+             config->hash_mb);
+  }
+}
+
+Engine init_engine(const EngineConfig config, const uint64_t seed) {
+  Engine engine = {.config = config, .tree = {.root = MCTS_NO_NODE}};
+
+  if (config.kind == EngineMcts)
+    engine.tree = init_mcts_tree(ENGINE_MCTS_CAPACITY, seed);
+  else if (config.hash_mb > 0)
+    engine.tt = init_tt(config.hash_mb);
+  return engine;
+}
+
+void reset_engine(Engine *engine, const uint64_t seed) {
+  if (engine->tree.nodes != NULL) {
+    engine->tree.root = MCTS_NO_NODE;
+    engine->tree.count = 0;
+    engine->tree.rng = init_rng(seed);
+  }
+  if (engine->tt.entries != NULL)
+    clear_tt(&engine->tt);
+}
+
+void free_engine(Engine *engine) {
+  if (engine->tree.nodes != NULL)
+    free_mcts_tree(&engine->tree);
+  if (engine->tt.entries != NULL)
+    free_tt(&engine->tt);
+}
+
+bool engine_choose_move(Engine *engine, GameState *state, Move *move) {
+  const EngineConfig *config = &engine->config;
+
+  if (config->kind == EngineMcts) {
+    const MctsLimits limits = {.playouts = config->playouts,
+                               .time_limit_ms = config->time_ms,
+                               .threads = config->threads,
+                               .parallelism = config->parallelism};
+    const MctsResult result = mcts_search(&engine->tree, state, limits);
+    *move = result.best_move;
+    return result.found;
+  }
+
+  const SearchLimits limits = {
+      .max_depth = config->depth,
+      .time_limit_ms = config->time_ms,
+      .threads = config->threads,
+      .tt = engine->tt.entries != NULL ? &engine->tt : NULL};
+  const SearchResult result = search_best_move(state, limits);
+  *move = result.best_move;
+  return result.found;
+}
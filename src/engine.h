@@ -0,0 +1,100 @@
+#ifndef ENGINE_H
+#define ENGINE_H
+#include "mcts.h"
+#include "search.h"
+
+/**
+ * @brief Moteurs disponibles.
+ */
+typedef enum {
+  EngineAlphaBeta, ///< Recherche alpha-beta (`search_best_move`)
+  EngineMcts       ///< Recherche Monte Carlo (`mcts_search`)
+} EngineKind;
+
+/**
+ * @brief Réglages d'un moteur, utilisés par les outils qui font jouer des
+ * parties sans intervention (parties automatiques, matchs).
+ *
+ * Sans limite de temps, un moteur joue de façon reproductible : à profondeur
+ * ou à nombre de simulations fixés, avec un générateur initialisé par
+ * `reset_engine`.
+ */
+typedef struct {
+  EngineKind kind;
+  uint8_t depth;               ///< Profondeur alpha-beta (0 : illimitée)
+  uint32_t playouts;           ///< Simulations Monte Carlo (0 : illimitées)
+  uint32_t time_ms;            ///< Temps par coup (0 : illimité)
+  uint32_t threads;            ///< Threads de la recherche
+  MctsParallelism parallelism; ///< Répartition Monte Carlo
+  uint32_t hash_mb;            ///< Table de transposition (0 : aucune)
+} EngineConfig;
+
+/**
+ * @brief Moteur prêt à jouer : réglages et mémoire de recherche.
+ */
+typedef struct {
+  EngineConfig config;
+  TranspositionTable tt; ///< Table alpha-beta (si `hash_mb > 0`)
+  MctsTree tree;         ///< Arbre Monte Carlo (moteur `EngineMcts`)
+} Engine;
+
+/**
+ * @brief Lit des réglages écrits sous la forme `moteur[:clé=valeur,...]`.
+ *
+ * Exemples : `alphabeta:depth=3`, `mcts:playouts=2000,threads=2`. Clés
+ * reconnues : `depth`, `playouts`, `time`, `threads`, `hash`, `parallel`
+ * (`tree` ou `root`). Les clés absentes gardent leur valeur par défaut.
+ *
+ * @param spec La chaîne à lire.
+ * @param config Reçoit les réglages.
+ * @return bool `false` si la chaîne est invalide.
+ */
+bool parse_engine_config(const char *spec, EngineConfig *config);
+
+/**
+ * @brief Décrit des réglages dans le format de `parse_engine_config`.
+ *
+ * @param config Les réglages à décrire.
+ * @param out Tampon de destination.
+ * @param size Taille du tampon.
+ */
+void format_engine_config(const EngineConfig *config, char *out, size_t size);
+
+/**
+ * @brief Alloue la mémoire de recherche d'un moteur.
+ *
+ * @param config Les réglages du moteur.
+ * @param seed Graine du générateur Monte Carlo.
+ * @return Engine Le moteur, à libérer avec `free_engine`.
+ */
+Engine init_engine(EngineConfig config, uint64_t seed);
+
+/**
+ * @brief Prépare le moteur pour une nouvelle partie.
+ *
+ * Vide la table et l'arbre, et réinitialise le générateur : deux parties
+ * jouées avec la même graine sont identiques.
+ *
+ * @param engine Pointeur vers le moteur.
+ * @param seed La graine de la partie.
+ */
+void reset_engine(Engine *engine, uint64_t seed);
+
+/**
+ * @brief Libère la mémoire d'un moteur.
+ *
+ * @param engine Pointeur vers le moteur.
+ */
+void free_engine(Engine *engine);
+
+/**
+ * @brief Choisit un coup pour le joueur dont c'est le tour, sans le jouer.
+ *
+ * @param engine Pointeur vers le moteur.
+ * @param state Pointeur vers l'état de jeu, rendu inchangé.
+ * @param move Reçoit le coup choisi.
+ * @return bool `false` si le joueur n'a aucun coup légal.
+ */
+bool engine_choose_move(Engine *engine, GameState *state, Move *move);
+
+#endif // ENGINE_H
@@ -0,0 +1,406 @@
+#include "game_archive.h"
+#include "move.h"
+#include "pool.h"
+#include "thread.h"
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Position des champs de l'en-tête
+#define HEADER_VERSION 4
+#define HEADER_COUNT 8
+#define HEADER_OFFSETS 16
+#define HEADER_HASHES 24
+
+// Position des champs d'une partie
+#define GAME_MODE 0
+#define GAME_DIM 1
+#define GAME_WHITE 2
+#define GAME_RESULT 3
+#define GAME_MOVES 4 // nombre de coups puis coups, longueur variable
+
+#define HASH_ENTRY_SIZE 16
+
+static void write_u32(unsigned char *out, const uint32_t value) {
+  for (int i = 0; i < 4; ++i)
+    out[i] = (unsigned char)(value >> (8 * i));
+}
+
+static void write_u64(unsigned char *out, const uint64_t value) {
+  write_u32(out, (uint32_t)value);
+  write_u32(out + 4, (uint32_t)(value >> 32));
+}
+
+static uint32_t read_u32(const unsigned char *in) {
+  return (uint32_t)in[0] | (uint32_t)in[1] << 8 | (uint32_t)in[2] << 16 |
+         (uint32_t)in[3] << 24;
+}
+
+static uint64_t read_u64(const unsigned char *in) {
+  return (uint64_t)read_u32(in) | (uint64_t)read_u32(in + 4) << 32;
+}
+
+static unsigned char *put_varint(unsigned char *out, uint32_t value) {
+  while (value >= 0x80) {
+    *out++ = (unsigned char)(value | 0x80);
+    value >>= 7;
+  }
+  *out++ = (unsigned char)value;
+  return out;
+}
+
+// `false` si l'entier dépasse `end` ou 32 bits
+static bool take_varint(const unsigned char **cursor,
+                        const unsigned char *end, uint32_t *value) {
+  uint32_t result = 0;
+  for (int shift = 0; shift < 32 && *cursor < end; shift += 7) {
+    const unsigned char byte = *(*cursor)++;
+    result |= (uint32_t)(byte & 0x7F) << shift;
+    if (!(byte & 0x80)) {
+      *value = result;
+      return true;
+    }
+  }
+  return false;
+}
+
+/*
+ * Écriture
+ */
+
+static void write_bytes(ArchiveWriter *writer, const void *data,
+                        const size_t size) {
+  if (writer->failed)
+    return;
+  if (fwrite(data, 1, size, writer->file) != size)
+    writer->failed = true;
+  writer->size += size;
+}
+
+bool open_archive_writer(ArchiveWriter *writer, const char *path) {
+  memset(writer, 0, sizeof(ArchiveWriter));
+  writer->file = fopen(path, "wb");
+  if (!writer->file)
+    return false;
+
+  // En-tête à zéro, réécrit à la fermeture
+  const unsigned char header[ARCHIVE_HEADER_SIZE] = {0};
+  write_bytes(writer, header, sizeof(header));
+  return !writer->failed;
+}
+
+bool archive_game(ArchiveWriter *writer, const GameRecord *record) {
+  if (record->count > (uint32_t)record->dim * record->dim)
+    return false;
+
+  if (writer->count == writer->capacity) {
+    writer->capacity = writer->capacity ? writer->capacity * 2 : 1024;
+    writer->offsets =
+        realloc(writer->offsets, writer->capacity * sizeof(uint64_t));
+    writer->hashes =
+        realloc(writer->hashes, writer->capacity * sizeof(ArchiveHashEntry));
+    if (writer->offsets == NULL || writer->hashes == NULL) {
+      perror("Failed to allocate memory for the archive index");
+      exit(EXIT_FAILURE);
+    }
+  }
+
+  unsigned char bytes[ARCHIVE_RECORD_MAX_SIZE];
+  bytes[GAME_MODE] = (unsigned char)record->mode;
+  bytes[GAME_DIM] = record->dim;
+  bytes[GAME_WHITE] = (unsigned char)record->white;
+  bytes[GAME_RESULT] = (unsigned char)record->result;
+  unsigned char *cursor = put_varint(bytes + GAME_MOVES, record->count);
+
+  GameState state =
+      init_game_state_with(record->mode, record->dim, record->white);
+  for (uint32_t ply = 0; ply < record->count; ++ply) {
+    const Move move = record->moves[ply];
+    const uint32_t square = (uint32_t)move.y * record->dim + move.x;
+    cursor = put_varint(cursor, move.kind + 6 * square);
+    UndoRecord undo;
+    make_move(&state, move, &undo);
+  }
+
+  writer->offsets[writer->count] = writer->size;
+  writer->hashes[writer->count] =
+      (ArchiveHashEntry){.hash = state.hash, .id = writer->count};
+  writer->count++;
+  free_game_state(&state);
+
+  write_bytes(writer, bytes, (size_t)(cursor - bytes));
+  return !writer->failed;
+}
+
+static int compare_hash_entries(const void *a, const void *b) {
+  const ArchiveHashEntry *left = a;
+  const ArchiveHashEntry *right = b;
+  if (left->hash != right->hash)
+    return left->hash < right->hash ? -1 : 1;
+  return left->id < right->id ? -1 : left->id > right->id;
+}
+
+bool close_archive_writer(ArchiveWriter *writer) {
+  unsigned char bytes[HASH_ENTRY_SIZE] = {0};
+
+  // Table des débuts, alignée sur 8 octets
+  const uint64_t end = writer->size;
+  write_bytes(writer, bytes, (size_t)((8 - end % 8) % 8));
+  const uint64_t offsets = writer->size;
+  for (uint32_t i = 0; i <= writer->count; ++i) {
+    write_u64(bytes, i < writer->count ? writer->offsets[i] : end);
+    write_bytes(writer, bytes, 8);
+  }
+
+  qsort(writer->hashes, writer->count, sizeof(ArchiveHashEntry),
+        compare_hash_entries);
+  const uint64_t hashes = writer->size;
+  memset(bytes, 0, sizeof(bytes));
+  for (uint32_t i = 0; i < writer->count; ++i) {
+    write_u64(bytes, writer->hashes[i].hash);
+    write_u32(bytes + 8, writer->hashes[i].id);
+    write_bytes(writer, bytes, HASH_ENTRY_SIZE);
+  }
+
+  // L'en-tête en dernier : l'archive n'est reconnue qu'une fois complète
+  unsigned char header[ARCHIVE_HEADER_SIZE] = {0};
+  memcpy(header, ARCHIVE_MAGIC, 4);
+  header[HEADER_VERSION] = ARCHIVE_VERSION;
+  write_u32(header + HEADER_COUNT, writer->count);
+  write_u64(header + HEADER_OFFSETS, offsets);
+  write_u64(header + HEADER_HASHES, hashes);
+  if (!writer->failed && (fflush(writer->file) != 0 ||
+                          fseek(writer->file, 0, SEEK_SET) != 0))
+    writer->failed = true;
+  write_bytes(writer, header, sizeof(header));
+
+  bool success = !writer->failed;
+  const int error = errno;
+  if (fclose(writer->file) != 0)
+    success = false;
+  else if (!success)
+    errno = error; // celle de l'écriture qui a échoué
+
+  free(writer->offsets);
+  free(writer->hashes);
+  memset(writer, 0, sizeof(ArchiveWriter));
+  return success;
+}
+
+/*
+ * Lecture
+ */
+
+DeserializeResult open_game_archive(const char *path, GameArchive *archive) {
+  memset(archive, 0, sizeof(GameArchive));
+  if (!map_file(path, &archive->mapped))
+    return DESERIALIZE_IO_ERROR;
+
+  const unsigned char *data = archive->mapped.data;
+  const uint64_t size = archive->mapped.size;
+  DeserializeResult result = DESERIALIZE_SUCCESS;
+
+  if (size < ARCHIVE_HEADER_SIZE || memcmp(data, ARCHIVE_MAGIC, 4) != 0) {
+    result = DESERIALIZE_INVALID_FORMAT;
+  } else if (data[HEADER_VERSION] != ARCHIVE_VERSION) {
+    result = DESERIALIZE_UNSUPPORTED_VERSION;
+  } else {
+    const uint64_t count = read_u32(data + HEADER_COUNT);
+    const uint64_t offsets = read_u64(data + HEADER_OFFSETS);
+    const uint64_t hashes = read_u64(data + HEADER_HASHES);
+
+    // Index à leur place, après les parties
+    if (offsets < ARCHIVE_HEADER_SIZE || offsets > size ||
+        (size - offsets) / 8 < count + 1 ||
+        hashes < offsets + 8 * (count + 1) || hashes > size ||
+        (size - hashes) / HASH_ENTRY_SIZE < count) {
+      result = DESERIALIZE_INVALID_FORMAT;
+    } else {
+      archive->count = (uint32_t)count;
+      archive->offsets = data + offsets;
+      archive->hashes = data + hashes;
+
+      // Parties à la suite, entre l'en-tête et les index
+      uint64_t previous = ARCHIVE_HEADER_SIZE;
+      for (uint64_t i = 0; i <= count && result == DESERIALIZE_SUCCESS; ++i) {
+        const uint64_t start = read_u64(archive->offsets + 8 * i);
+        if (start < previous || start > offsets ||
+            (i == 0 && start != ARCHIVE_HEADER_SIZE))
+          result = DESERIALIZE_INVALID_FORMAT;
+        previous = start;
+      }
+    }
+  }
+
+  if (result != DESERIALIZE_SUCCESS)
+    unmap_file(&archive->mapped);
+  return result;
+}
+
+void close_game_archive(GameArchive *archive) {
+  unmap_file(&archive->mapped);
+  memset(archive, 0, sizeof(GameArchive));
+}
+
+// Décode la partie n° `id` dans `record`, dont les tampons sont réutilisés
+static DeserializeResult decode_game(const GameArchive *archive,
+                                     const uint32_t id, GameRecord *record) {
+  const unsigned char *data = archive->mapped.data;
+  const unsigned char *cursor = data + read_u64(archive->offsets + 8 * id);
+  const unsigned char *end = data + read_u64(archive->offsets + 8 * id + 8);
+
+  if (end - cursor < GAME_MOVES)
+    return DESERIALIZE_INVALID_FORMAT;
+  const uint8_t dim = cursor[GAME_DIM];
+  if (cursor[GAME_MODE] != Conquest && cursor[GAME_MODE] != Connect)
+    return DESERIALIZE_INVALID_MODE;
+  if (dim < 6 || dim > 12)
+    return DESERIALIZE_INVALID_DIMENSION;
+  if (cursor[GAME_WHITE] > Opponent)
+    return DESERIALIZE_INVALID_PLAYER;
+  if (cursor[GAME_RESULT] > RecordDraw)
+    return DESERIALIZE_INVALID_FORMAT;
+
+  record->mode = (GameMode)cursor[GAME_MODE];
+  record->dim = dim;
+  record->white = (Player)cursor[GAME_WHITE];
+  record->result = (RecordResult)cursor[GAME_RESULT];
+  record->count = 0;
+  cursor += GAME_MOVES;
+
+  uint32_t count;
+  if (!take_varint(&cursor, end, &count) || count > (uint32_t)dim * dim)
+    return DESERIALIZE_INVALID_FORMAT;
+  for (uint32_t ply = 0; ply < count; ++ply) {
+    uint32_t value;
+    if (!take_varint(&cursor, end, &value) || value >= 6u * dim * dim)
+      return DESERIALIZE_INVALID_FORMAT;
+    const uint32_t square = value / 6;
+    record_move(record,
+                (Move){.kind = (uint8_t)(value % 6),
+                       .x = (uint8_t)(square % dim),
+                       .y = (uint8_t)(square / dim)},
+                RECORD_NO_TIME);
+  }
+  return cursor == end ? DESERIALIZE_SUCCESS : DESERIALIZE_INVALID_FORMAT;
+}
+
+DeserializeResult read_archived_game(const GameArchive *archive,
+                                     const uint32_t id, GameRecord *record) {
+  if (id >= archive->count)
+    return DESERIALIZE_NULL_INPUT;
+
+  *record = init_game_record(Conquest, 0, User);
+  const DeserializeResult result = decode_game(archive, id, record);
+  if (result != DESERIALIZE_SUCCESS)
+    free_game_record(record);
+  return result;
+}
+
+uint32_t find_archived_games(const GameArchive *archive, const uint64_t hash,
+                             uint32_t *ids, const uint32_t capacity) {
+  // Première entrée dont la clé n'est pas inférieure à `hash`
+  uint32_t low = 0;
+  uint32_t high = archive->count;
+  while (low < high) {
+    const uint32_t middle = low + (high - low) / 2;
+    if (read_u64(archive->hashes + (size_t)middle * HASH_ENTRY_SIZE) < hash)
+      low = middle + 1;
+    else
+      high = middle;
+  }
+
+  uint32_t found = 0;
+  for (uint32_t i = low; i < archive->count; ++i) {
+    const unsigned char *entry = archive->hashes + (size_t)i * HASH_ENTRY_SIZE;
+    if (read_u64(entry) != hash)
+      break;
+    if (found < capacity)
+      ids[found] = read_u32(entry + 8);
+    found++;
+  }
+  return found;
+}
+
+void init_archive_iterator(ArchiveIterator *iterator,
+                           const GameArchive *archive, const uint32_t first) {
+  *iterator = (ArchiveIterator){.archive = archive,
+                                .next = first,
+                                .record = init_game_record(Conquest, 0, User),
+                                .status = DESERIALIZE_SUCCESS};
+}
+
+bool next_archived_game(ArchiveIterator *iterator, uint32_t *id) {
+  if (iterator->status != DESERIALIZE_SUCCESS ||
+      iterator->next >= iterator->archive->count)
+    return false;
+
+  iterator->status =
+      decode_game(iterator->archive, iterator->next, &iterator->record);
+  if (iterator->status != DESERIALIZE_SUCCESS)
+    return false;
+  if (id)
+    *id = iterator->next;
+  iterator->next++;
+  return true;
+}
+
+void free_archive_iterator(ArchiveIterator *iterator) {
+  free_game_record(&iterator->record);
+}
+
+/*
+ * Parcours sur plusieurs threads
+ */
+
+typedef struct {
+  const GameArchive *archive;
+  ArchiveTask task;
+  void *context;
+  GameRecord *records;      // Un par thread
+  volatile uint32_t status; // Première erreur rencontrée
+} ArchiveScan;
+
+static void scan_chunk(void *arg, const uint32_t worker, const uint32_t index) {
+  ArchiveScan *scan = arg;
+  GameRecord *record = &scan->records[worker];
+  const uint32_t first = index * ARCHIVE_SCAN_CHUNK;
+  const uint32_t count = scan->archive->count - first < ARCHIVE_SCAN_CHUNK
+                             ? scan->archive->count - first
+                             : ARCHIVE_SCAN_CHUNK;
+
+  for (uint32_t id = first; id < first + count; ++id) {
+    const DeserializeResult result = decode_game(scan->archive, id, record);
+    if (result != DESERIALIZE_SUCCESS) {
+      // Seule la première erreur est gardée
+      uint32_t expected = DESERIALIZE_SUCCESS;
+      atomic_cas_u32(&scan->status, &expected, result);
+      continue;
+    }
+    scan->task(scan->context, worker, id, record);
+  }
+}
+
+DeserializeResult scan_game_archive(const GameArchive *archive,
+                                    uint32_t threads, const ArchiveTask task,
+                                    void *context) {
+  if (threads == 0)
+    threads = 1;
+
+  ArchiveScan scan = {.archive = archive, .task = task, .context = context};
+  scan.records = calloc(threads, sizeof(GameRecord));
+  if (scan.records == NULL) {
+    perror("Failed to allocate memory for the archive scan");
+    exit(EXIT_FAILURE);
+  }
+
+  const uint32_t chunks =
+      (uint32_t)(((uint64_t)archive->count + ARCHIVE_SCAN_CHUNK - 1) /
+                 ARCHIVE_SCAN_CHUNK);
+  parallel_for(threads, chunks, scan_chunk, &scan);
+
+  for (uint32_t i = 0; i < threads; ++i)
+    free_game_record(&scan.records[i]);
+  free(scan.records);
+  return (DeserializeResult)atomic_load_acquire_u32(&scan.status);
+}
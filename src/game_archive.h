@@ -0,0 +1,227 @@
+#ifndef GAME_ARCHIVE_H
+#define GAME_ARCHIVE_H
+#include "game_record.h"
+#include "save.h"
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#define ARCHIVE_MAGIC "IF2A" ///< Début de toute archive de parties
+#define ARCHIVE_VERSION 1
+#define ARCHIVE_HEADER_SIZE 32
+/// Partie la plus longue : en-tête, nombre de coups, 144 coups de 2 octets
+#define ARCHIVE_RECORD_MAX_SIZE (4 + 2 + 2 * 12 * 12)
+/// Parties décodées d'affilée par un thread de `scan_game_archive`
+#define ARCHIVE_SCAN_CHUNK 256
+
+/**
+ * @brief Entrée de l'index par position finale, triée par clé.
+ */
+typedef struct {
+  uint64_t hash; ///< Clé de Zobrist de la position finale
+  uint32_t id;   ///< Numéro de la partie
+} ArchiveHashEntry;
+
+/**
+ * @brief Écriture d'une archive, une partie après l'autre.
+ *
+ * Les parties sont écrites au fur et à mesure ; seuls les index (24 octets
+ * par partie) restent en mémoire jusqu'à `close_archive_writer`.
+ */
+typedef struct {
+  FILE *file;
+  uint64_t size;            ///< Octets écrits jusqu'ici
+  uint64_t *offsets;        ///< Début de chaque partie
+  ArchiveHashEntry *hashes; ///< Position finale de chaque partie
+  uint32_t count;
+  uint32_t capacity;
+  bool failed; ///< Une écriture a échoué
+} ArchiveWriter;
+
+/**
+ * @brief Archive ouverte en lecture, projetée en mémoire.
+ *
+ * Format, entiers petit-boutistes :
+ * - en-tête de `ARCHIVE_HEADER_SIZE` octets : 0 à 3 `ARCHIVE_MAGIC`,
+ *   4 version, 8 à 11 nombre de parties, 16 à 23 position de la table des
+ *   débuts, 24 à 31 position de l'index par position finale ;
+ * - les parties, à la suite : mode (`GameMode`), dimension, joueur blanc
+ *   (`Player`), résultat (`RecordResult`), nombre de coups puis chaque coup,
+ *   en entiers de longueur variable (7 bits par octet, bit 7 : octet
+ *   suivant). Un coup vaut `kind + 6 * (y * dim + x)` : un octet sur les 21
+ *   premières cases, deux au-delà ;
+ * - la table des débuts, alignée sur 8 octets : `count + 1` positions sur
+ *   8 octets, la dernière étant la fin des parties ;
+ * - l'index : `count` entrées de 16 octets (clé de la position finale sur
+ *   8, numéro de la partie sur 4, puis 4 octets à zéro), triées par clé puis
+ *   par numéro.
+ *
+ * Les temps des coups (`times_ms`) ne sont pas conservés.
+ */
+typedef struct {
+  MappedFile mapped;
+  uint32_t count;               ///< Nombre de parties
+  const unsigned char *offsets; ///< Table des débuts, dans la projection
+  const unsigned char *hashes;  ///< Index par position finale
+} GameArchive;
+
+/**
+ * @brief Parcours des parties d'une archive dans l'ordre.
+ */
+typedef struct {
+  const GameArchive *archive;
+  uint32_t next;            ///< Numéro de la prochaine partie
+  GameRecord record;        ///< Partie courante, tampons réutilisés
+  DeserializeResult status; ///< Cause de l'arrêt si une partie est illisible
+} ArchiveIterator;
+
+/**
+ * @brief Tâche exécutée pour chaque partie d'un `scan_game_archive`.
+ *
+ * @param context Le contexte passé à `scan_game_archive`.
+ * @param worker Numéro du thread (cf. `PoolTask`).
+ * @param id Numéro de la partie.
+ * @param record La partie, valide pendant l'appel uniquement.
+ */
+typedef void (*ArchiveTask)(void *context, uint32_t worker, uint32_t id,
+                            const GameRecord *record);
+
+/**
+ * @brief Crée une archive vide.
+ *
+ * L'en-tête n'est écrit que par `close_archive_writer` : une archive
+ * interrompue n'est pas reconnue par `open_game_archive`.
+ *
+ * @param writer Pointeur vers l'écriture à préparer.
+ * @param path Le chemin de l'archive.
+ * @return bool `false` si le fichier n'a pas pu être créé, avec `errno`
+ * renseigné.
+ */
+bool open_archive_writer(ArchiveWriter *writer, const char *path);
+
+/**
+ * @brief Ajoute une partie à la fin de l'archive.
+ *
+ * La partie est rejouée pour connaître sa position finale : ses coups
+ * doivent être légaux (partie jouée ou lue par `parse_game_record`).
+ *
+ * @param writer Pointeur vers l'écriture.
+ * @param record Pointeur vers la partie.
+ * @return bool `false` si la partie n'a pas pu être écrite (plus de coups
+ * que de cases, erreur d'écriture).
+ */
+bool archive_game(ArchiveWriter *writer, const GameRecord *record);
+
+/**
+ * @brief Écrit les index et l'en-tête puis ferme l'archive.
+ *
+ * @param writer Pointeur vers l'écriture.
+ * @return bool `false` si une écriture a échoué depuis
+ * `open_archive_writer`, avec `errno` renseigné.
+ */
+bool close_archive_writer(ArchiveWriter *writer);
+
+/**
+ * @brief Ouvre une archive en la projetant en mémoire.
+ *
+ * L'en-tête, la place des index et l'ordre de la table des débuts sont
+ * vérifiés ici ; chaque partie l'est quand elle est décodée. Rien n'est lu
+ * d'autre : l'ouverture d'une archive de plusieurs millions de parties ne
+ * coûte qu'un parcours de sa table des débuts.
+ *
+ * @param path Le chemin de l'archive.
+ * @param archive Pointeur vers l'archive à remplir (à fermer avec
+ * `close_game_archive` en cas de succès uniquement).
+ * @return DeserializeResult `DESERIALIZE_SUCCESS` ou la cause de l'échec.
+ */
+DeserializeResult open_game_archive(const char *path, GameArchive *archive);
+
+/**
+ * @brief Ferme une archive ouverte par `open_game_archive`.
+ *
+ * @param archive Pointeur vers l'archive.
+ */
+void close_game_archive(GameArchive *archive);
+
+/**
+ * @brief Décode une partie d'après son numéro.
+ *
+ * La structure de la partie est vérifiée (champs, cases, taille) mais ses
+ * coups ne sont pas rejoués : `parse_game_record` reste la lecture qui
+ * vérifie la légalité.
+ *
+ * @param archive Pointeur vers l'archive.
+ * @param id Numéro de la partie, de 0 à `count - 1`.
+ * @param record Reçoit la partie (à libérer avec `free_game_record` en cas
+ * de succès uniquement).
+ * @return DeserializeResult `DESERIALIZE_SUCCESS` ou la cause de l'échec
+ * (`DESERIALIZE_NULL_INPUT` si la partie n'existe pas).
+ */
+DeserializeResult read_archived_game(const GameArchive *archive, uint32_t id,
+                                     GameRecord *record);
+
+/**
+ * @brief Cherche les parties qui se terminent sur une position donnée.
+ *
+ * Recherche dichotomique dans l'index : aucune partie n'est décodée.
+ *
+ * @param archive Pointeur vers l'archive.
+ * @param hash Clé de Zobrist de la position finale (`GameState.hash`).
+ * @param ids Reçoit les numéros des parties trouvées, dans l'ordre.
+ * @param capacity Nombre de numéros que peut recevoir `ids`.
+ * @return uint32_t Le nombre de parties trouvées, éventuellement plus grand
+ * que `capacity`.
+ */
+uint32_t find_archived_games(const GameArchive *archive, uint64_t hash,
+                             uint32_t *ids, uint32_t capacity);
+
+/**
+ * @brief Prépare le parcours des parties à partir de la n° `first`.
+ *
+ * @param iterator Pointeur vers le parcours.
+ * @param archive Pointeur vers l'archive.
+ * @param first Numéro de la première partie.
+ */
+void init_archive_iterator(ArchiveIterator *iterator,
+                           const GameArchive *archive, uint32_t first);
+
+/**
+ * @brief Décode la partie suivante dans `iterator->record`.
+ *
+ * Les tampons de la partie sont réutilisés d'une partie à l'autre : un
+ * parcours n'alloue presque rien.
+ *
+ * @param iterator Pointeur vers le parcours.
+ * @param id Si non NULL, reçoit le numéro de la partie.
+ * @return bool `false` à la fin de l'archive ou sur une partie illisible
+ * (`iterator->status`).
+ */
+bool next_archived_game(ArchiveIterator *iterator, uint32_t *id);
+
+/**
+ * @brief Libère les tampons d'un parcours.
+ *
+ * @param iterator Pointeur vers le parcours.
+ */
+void free_archive_iterator(ArchiveIterator *iterator);
+
+/**
+ * @brief Exécute `task` pour chaque partie de l'archive sur plusieurs
+ * threads.
+ *
+ * Les parties sont réparties par `parallel_for` par paquets de
+ * `ARCHIVE_SCAN_CHUNK`, chaque thread décodant dans ses propres tampons.
+ * L'ordre des appels n'est pas celui des numéros.
+ *
+ * @param archive Pointeur vers l'archive.
+ * @param threads Nombre de threads.
+ * @param task La tâche à exécuter.
+ * @param context Pointeur transmis à chaque appel de `task`.
+ * @return DeserializeResult `DESERIALIZE_SUCCESS`, ou la cause de l'échec
+ * si une partie est illisible (elle est alors sautée).
+ */
+DeserializeResult scan_game_archive(const GameArchive *archive,
+                                    uint32_t threads, ArchiveTask task,
+                                    void *context);
+
+#endif // GAME_ARCHIVE_H
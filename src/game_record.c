@@ -0,0 +1,478 @@
+#include "game_record.h"
+#include "movegen.h"
+#include "search.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define RECORD_LINE_WIDTH 79 // Longueur maximale d'une ligne de coups
+
+static const char piece_letters[] = "KQRBNP"; // Indexé par `PieceKind`
+static const char *result_names[] = {"*", "1-0", "0-1", "1/2-1/2"};
+
+// Champs d'en-tête obligatoires
+#define TAG_MODE 1
+#define TAG_DIM 2
+#define TAG_WHITE 4
+#define TAG_REQUIRED 7
+#define TAG_RESULT 8
+
+GameRecord init_game_record(const GameMode mode, const uint8_t dim,
+                            const Player white) {
+  return (GameRecord){.mode = mode,
+                      .dim = dim,
+                      .white = white,
+                      .result = RecordUnfinished};
+}
+
+void record_move(GameRecord *record, const Move move, const uint32_t time_ms) {
+  if (record->count == record->capacity) {
+    record->capacity = record->capacity ? record->capacity * 2 : 32;
+    record->moves = realloc(record->moves, record->capacity * sizeof(Move));
+    record->times_ms =
+        realloc(record->times_ms, record->capacity * sizeof(uint32_t));
+    if (record->moves == NULL || record->times_ms == NULL) {
+      perror("Failed to allocate memory for a game record");
+      exit(EXIT_FAILURE);
+    }
+  }
+  record->moves[record->count] = move;
+  record->times_ms[record->count] = time_ms;
+  record->count++;
+}
+
+RecordResult result_of_game(const GameState *state, const Player white) {
+  // Même fin que le jeu : plus de pièces ou plus aucune case légale
+  Move moves[MAX_MOVES];
+  if (!is_game_over(state) && generate_moves(state, moves) > 0)
+    return RecordUnfinished;
+
+  const int score = compare_scores(state, white);
+  return score > 0 ? RecordWhiteWins : score < 0 ? RecordBlackWins : RecordDraw;
+}
+
+void free_game_record(GameRecord *record) {
+  free(record->moves);
+  free(record->times_ms);
+  record->moves = NULL;
+  record->times_ms = NULL;
+  record->count = record->capacity = 0;
+}
+
+/*
+ * Écriture
+ */
+
+// Texte en cours d'écriture : `length` continue de compter au-delà de
+// `capacity`, comme `snprintf`
+typedef struct {
+  char *out;
+  size_t capacity;
+  size_t length;
+  size_t column;
+} RecordWriter;
+
+static void put_text(RecordWriter *writer, const char *text,
+                     const size_t length) {
+  if (writer->length < writer->capacity) {
+    const size_t room = writer->capacity - writer->length;
+    memcpy(writer->out + writer->length, text, length < room ? length : room);
+  }
+  writer->length += length;
+  writer->column += length;
+}
+
+static void put_line(RecordWriter *writer, const char *text) {
+  put_text(writer, text, strlen(text));
+  put_text(writer, "\n", 1);
+  writer->column = 0;
+}
+
+// Mot des coups, précédé d'une espace ou d'un retour à la ligne
+static void put_word(RecordWriter *writer, const char *word) {
+  const size_t length = strlen(word);
+  if (writer->column > 0) {
+    if (writer->column + 1 + length > RECORD_LINE_WIDTH) {
+      put_text(writer, "\n", 1);
+      writer->column = 0;
+    } else {
+      put_text(writer, " ", 1);
+    }
+  }
+  put_text(writer, word, length);
+}
+
+size_t format_game_record(const GameRecord *record, char *out,
+                          const size_t capacity) {
+  RecordWriter writer = {.out = out, .capacity = capacity};
+  char word[32];
+
+  snprintf(word, sizeof(word), "[Mode \"%s\"]",
+           record->mode == Conquest ? "Conquest" : "Connect");
+  put_line(&writer, word);
+  snprintf(word, sizeof(word), "[Dim \"%u\"]", record->dim);
+  put_line(&writer, word);
+  snprintf(word, sizeof(word), "[White \"%s\"]",
+           stringify_player(record->white));
+  put_line(&writer, word);
+  snprintf(word, sizeof(word), "[Result \"%s\"]",
+           result_names[record->result]);
+  put_line(&writer, word);
+  put_line(&writer, "");
+
+  for (uint32_t ply = 0; ply < record->count; ++ply) {
+    const Move move = record->moves[ply];
+    if (ply % 2 == 0) {
+      snprintf(word, sizeof(word), "%u.", ply / 2 + 1);
+      put_word(&writer, word);
+    }
+
+    word[0] = piece_letters[move.kind];
+    word[1] = '@';
+    format_position(record->dim, move.x, move.y, word + 2);
+    put_word(&writer, word);
+
+    const uint32_t time_ms = record->times_ms[ply];
+    if (time_ms != RECORD_NO_TIME) {
+      snprintf(word, sizeof(word), "{[%%emt %u.%03u]}", time_ms / 1000,
+               time_ms % 1000);
+      put_word(&writer, word);
+    }
+  }
+  put_word(&writer, result_names[record->result]);
+  put_line(&writer, "");
+
+  // Zéro final, au besoin à la place du dernier octet
+  if (capacity > 0)
+    out[writer.length < capacity ? writer.length : capacity - 1] = '\0';
+  return writer.length;
+}
+
+/*
+ * Lecture
+ */
+
+typedef struct {
+  const char *start;
+  const char *cursor;
+  const char *end;
+} RecordParser;
+
+static bool is_space(const char c) {
+  return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
+
+static void skip_spaces(RecordParser *parser) {
+  while (parser->cursor < parser->end && is_space(*parser->cursor))
+    parser->cursor++;
+}
+
+// Longueur du mot qui commence au curseur (jusqu'à un blanc ou un commentaire)
+static size_t word_length(const RecordParser *parser) {
+  const char *c = parser->cursor;
+  while (c < parser->end && !is_space(*c) && *c != '{' && *c != ';')
+    c++;
+  return (size_t)(c - parser->cursor);
+}
+
+static bool equals(const char *text, const size_t length, const char *word) {
+  return strlen(word) == length && memcmp(text, word, length) == 0;
+}
+
+static bool parse_result(const char *text, const size_t length,
+                         RecordResult *result) {
+  for (int r = RecordUnfinished; r <= RecordDraw; ++r) {
+    if (equals(text, length, result_names[r])) {
+      *result = (RecordResult)r;
+      return true;
+    }
+  }
+  return false;
+}
+
+// `[Nom "valeur"]`
+static DeserializeResult parse_tag(RecordParser *parser, GameRecord *record,
+                                   unsigned *tags) {
+  const char *c = ++parser->cursor; // après '['
+  const char *end = parser->end;
+
+  const char *name = c;
+  while (c < end && !is_space(*c) && *c != '"' && *c != ']')
+    c++;
+  const size_t name_length = (size_t)(c - name);
+  while (c < end && is_space(*c))
+    c++;
+  if (c == end || *c != '"') {
+    parser->cursor = c;
+    return DESERIALIZE_INVALID_FORMAT;
+  }
+
+  const char *value = ++c;
+  while (c < end && *c != '"' && *c != '\n')
+    c++;
+  const size_t length = (size_t)(c - value);
+  if (c == end || *c != '"' || c + 1 == end || c[1] != ']') {
+    parser->cursor = c;
+    return DESERIALIZE_INVALID_FORMAT;
+  }
+  parser->cursor = value; // position de l'erreur éventuelle
+
+  if (equals(name, name_length, "Mode")) {
+    if (equals(value, length, "Conquest"))
+      record->mode = Conquest;
+    else if (equals(value, length, "Connect"))
+      record->mode = Connect;
+    else
+      return DESERIALIZE_INVALID_MODE;
+    *tags |= TAG_MODE;
+  } else if (equals(name, name_length, "Dim")) {
+    unsigned dim = 0;
+    for (size_t i = 0; i < length; ++i) {
+      if (value[i] < '0' || value[i] > '9' || i >= 2)
+        return DESERIALIZE_INVALID_FORMAT;
+      dim = dim * 10 + (unsigned)(value[i] - '0');
+    }
+    if (dim < 6 || dim > 12)
+      return DESERIALIZE_INVALID_DIMENSION;
+    record->dim = (uint8_t)dim;
+    *tags |= TAG_DIM;
+  } else if (equals(name, name_length, "White")) {
+    if (equals(value, length, "User"))
+      record->white = User;
+    else if (equals(value, length, "Opponent"))
+      record->white = Opponent;
+    else
+      return DESERIALIZE_INVALID_PLAYER;
+    *tags |= TAG_WHITE;
+  } else if (equals(name, name_length, "Result")) {
+    if (!parse_result(value, length, &record->result))
+      return DESERIALIZE_INVALID_FORMAT;
+    *tags |= TAG_RESULT;
+  }
+  // autres étiquettes (Event, Date...) : ignorées
+
+  parser->cursor = c + 2;
+  return DESERIALIZE_SUCCESS;
+}
+
+// `{[%emt 1.250]}` : temps du dernier coup, les autres commentaires sont
+// ignorés
+static DeserializeResult parse_comment(RecordParser *parser,
+                                       GameRecord *record) {
+  const char *open = parser->cursor;
+  const char *close = memchr(open, '}', (size_t)(parser->end - open));
+  if (!close)
+    return DESERIALIZE_INVALID_FORMAT;
+  parser->cursor = close + 1;
+
+  static const char emt[] = "[%emt ";
+  const char *c = open + 1;
+  if (record->count == 0 || (size_t)(close - c) < sizeof(emt) - 1 ||
+      memcmp(c, emt, sizeof(emt) - 1) != 0)
+    return DESERIALIZE_SUCCESS;
+
+  c += sizeof(emt) - 1;
+  uint64_t ms = 0;
+  while (c < close && *c >= '0' && *c <= '9')
+    ms = ms * 10 + (uint64_t)(*c++ - '0');
+  ms *= 1000;
+  if (c < close && *c == '.') {
+    uint64_t scale = 100;
+    for (c++; c < close && *c >= '0' && *c <= '9'; c++, scale /= 10)
+      ms += (uint64_t)(*c - '0') * scale;
+  }
+  if (ms < RECORD_NO_TIME)
+    record->times_ms[record->count - 1] = (uint32_t)ms;
+  return DESERIALIZE_SUCCESS;
+}
+
+// `Q@A3`, joué sur `state` s'il est permis
+static DeserializeResult parse_move(const char *word, const size_t length,
+                                    GameState *state, GameRecord *record) {
+  const char *letter = memchr(piece_letters, word[0], 6);
+  if (length < 4 || length > 5 || !letter || word[1] != '@')
+    return DESERIALIZE_INVALID_FORMAT;
+
+  char square[4] = {0};
+  memcpy(square, word + 2, length - 2);
+  Move move = {.kind = (uint8_t)(letter - piece_letters)};
+  if (!parse_position(state->board.dim, square, &move.x, &move.y))
+    return DESERIALIZE_INVALID_FORMAT;
+
+  if (is_game_over(state) ||
+      get_piece_count(get_user_turn_count_tracker(state),
+                      (PieceKind)move.kind) == 0)
+    return DESERIALIZE_ILLEGAL_MOVE;
+  const BitBoard legal = legal_squares_for(state, (PieceKind)move.kind);
+  if (!bb_test(&legal, move.x, move.y))
+    return DESERIALIZE_ILLEGAL_MOVE;
+
+  UndoRecord undo;
+  make_move(state, move, &undo);
+  record_move(record, move, RECORD_NO_TIME);
+  return DESERIALIZE_SUCCESS;
+}
+
+// Coups jusqu'au résultat final
+static DeserializeResult parse_moves(RecordParser *parser, GameState *state,
+                                     GameRecord *record,
+                                     RecordResult *result) {
+  for (;;) {
+    skip_spaces(parser);
+    if (parser->cursor == parser->end)
+      return DESERIALIZE_INVALID_FORMAT; // pas de résultat final
+
+    const char *word = parser->cursor;
+    DeserializeResult status = DESERIALIZE_SUCCESS;
+    switch (*word) {
+    case '{':
+      status = parse_comment(parser, record);
+      break;
+    case ';': {
+      const char *newline =
+          memchr(word, '\n', (size_t)(parser->end - word));
+      parser->cursor = newline ? newline + 1 : parser->end;
+      break;
+    }
+    default: {
+      const size_t length = word_length(parser);
+      if (parse_result(word, length, result)) {
+        parser->cursor += length;
+        return DESERIALIZE_SUCCESS;
+      }
+
+      if (*word >= '0' && *word <= '9') {
+        // numéro de coup : "12." ou "12..."
+        size_t i = 0;
+        while (i < length && word[i] >= '0' && word[i] <= '9')
+          i++;
+        if (i == length || word[i] != '.')
+          return DESERIALIZE_INVALID_FORMAT;
+        while (i < length && word[i] == '.')
+          i++;
+        if (i != length)
+          return DESERIALIZE_INVALID_FORMAT;
+      } else {
+        status = parse_move(word, length, state, record);
+      }
+      if (status == DESERIALIZE_SUCCESS)
+        parser->cursor += length;
+      break;
+    }
+    }
+
+    if (status != DESERIALIZE_SUCCESS)
+      return status;
+  }
+}
+
+DeserializeResult parse_game_record(const char *text, const size_t length,
+                                    GameRecord *record, size_t *offset) {
+  if (!text || !record)
+    return DESERIALIZE_NULL_INPUT;
+
+  *record = init_game_record(Conquest, 0, User);
+  RecordParser parser = {.start = text, .cursor = text, .end = text + length};
+  unsigned tags = 0;
+  DeserializeResult status = DESERIALIZE_SUCCESS;
+
+  skip_spaces(&parser);
+  while (status == DESERIALIZE_SUCCESS && parser.cursor < parser.end &&
+         *parser.cursor == '[') {
+    status = parse_tag(&parser, record, &tags);
+    skip_spaces(&parser);
+  }
+  if (status == DESERIALIZE_SUCCESS && (tags & TAG_REQUIRED) != TAG_REQUIRED)
+    status = DESERIALIZE_INVALID_FORMAT;
+
+  if (status == DESERIALIZE_SUCCESS) {
+    const RecordResult tag_result = record->result;
+    GameState state = init_game_state_with(record->mode, record->dim,
+                                           record->white);
+    status = parse_moves(&parser, &state, record, &record->result);
+    free_game_state(&state);
+
+    // Le résultat de l'en-tête, s'il est donné, doit être le même
+    if (status == DESERIALIZE_SUCCESS && (tags & TAG_RESULT) &&
+        tag_result != record->result)
+      status = DESERIALIZE_INVALID_FORMAT;
+  }
+
+  if (offset)
+    *offset = (size_t)(parser.cursor - parser.start);
+  if (status != DESERIALIZE_SUCCESS)
+    free_game_record(record);
+  return status;
+}
+
+/*
+ * Relecture
+ */
+
+bool replay_game_record(const GameRecord *record, const uint32_t ply,
+                        GameState *state) {
+  if (ply > record->count)
+    return false;
+
+  *state = init_game_state_with(record->mode, record->dim, record->white);
+  for (uint32_t i = 0; i < ply; ++i) {
+    UndoRecord undo;
+    make_move(state, record->moves[i], &undo);
+  }
+  return true;
+}
+
+// Copie à plat de la position n° `ply`
+static void store_position(GameReplay *replay, const uint32_t ply,
+                           const GameState *state) {
+  const uint8_t dim = replay->dim;
+  Tile *tiles = replay->tiles + (size_t)ply * dim * dim;
+
+  replay->states[ply] = *state;
+  replay->states[ply].board.tiles = NULL;
+  for (uint8_t y = 0; y < dim; ++y)
+    memcpy(tiles + (size_t)y * dim, state->board.tiles[y], dim * sizeof(Tile));
+}
+
+void init_game_replay(GameReplay *replay, const GameRecord *record) {
+  const size_t positions = (size_t)record->count + 1;
+  const size_t squares = (size_t)record->dim * record->dim;
+
+  replay->count = record->count;
+  replay->dim = record->dim;
+  replay->states = malloc(positions * sizeof(GameState));
+  replay->tiles = malloc(positions * squares * sizeof(Tile));
+  if (replay->states == NULL || replay->tiles == NULL) {
+    perror("Failed to allocate memory for a game replay");
+    exit(EXIT_FAILURE);
+  }
+
+  GameState state = init_game_state_with(record->mode, record->dim,
+                                         record->white);
+  store_position(replay, 0, &state);
+  for (uint32_t ply = 0; ply < record->count; ++ply) {
+    UndoRecord undo;
+    make_move(&state, record->moves[ply], &undo);
+    store_position(replay, ply + 1, &state);
+  }
+  free_game_state(&state);
+}
+
+void seek_game_replay(const GameReplay *replay, const uint32_t ply,
+                      GameState *state) {
+  const uint8_t dim = replay->dim;
+  const Tile *tiles = replay->tiles + (size_t)ply * dim * dim;
+  Tile **rows = state->board.tiles;
+
+  *state = replay->states[ply];
+  state->board.tiles = rows;
+  for (uint8_t y = 0; y < dim; ++y)
+    memcpy(rows[y], tiles + (size_t)y * dim, dim * sizeof(Tile));
+}
+
+void free_game_replay(GameReplay *replay) {
+  free(replay->states);
+  free(replay->tiles);
+  replay->states = NULL;
+  replay->tiles = NULL;
+}
@@ -0,0 +1,187 @@
+#ifndef GAME_RECORD_H
+#define GAME_RECORD_H
+#include "move.h"
+#include "save.h"
+#include <stddef.h>
+#include <stdint.h>
+
+#define RECORD_NO_TIME UINT32_MAX ///< Durée d'un coup inconnue
+
+/**
+ * @brief Issue d'une partie, comme le dernier mot d'une partie PGN.
+ */
+typedef enum {
+  RecordUnfinished = 0, ///< `*` : partie interrompue
+  RecordWhiteWins,      ///< `1-0`
+  RecordBlackWins,      ///< `0-1`
+  RecordDraw            ///< `1/2-1/2`
+} RecordResult;
+
+/**
+ * @brief Partie complète : conditions de départ et suite des coups.
+ *
+ * Le format texte reprend celui des parties PGN : des étiquettes d'en-tête,
+ * une ligne vide, puis les coups numérotés et le résultat.
+ *
+ * ```
+ * [Mode "Conquest"]
+ * [Dim "8"]
+ * [White "User"]
+ * [Result "1-0"]
+ *
+ * 1. Q@D5 {[%emt 1.250]} N@C3 2. P@A1 R@H8 ... 1-0
+ * ```
+ *
+ * Un coup est la pose d'une pièce, notée comme un parachutage de
+ * crazyhouse : l'initiale anglaise de la pièce (`KQRBNP`), `@` et la case
+ * dans la notation de `format_position` (celle que saisit le joueur, `A3`).
+ * Le commentaire `{[%emt secondes]}` qui peut suivre un coup donne le temps
+ * passé à le choisir ; les autres commentaires et étiquettes sont ignorés.
+ * Les blancs commencent (cf. `init_game_state_with`) et les coups
+ * alternent.
+ */
+typedef struct {
+  GameMode mode;
+  uint8_t dim;
+  Player white;        ///< Joueur qui a les blancs, donc qui commence
+  RecordResult result;
+  Move *moves;         ///< Coups dans l'ordre joué
+  uint32_t *times_ms;  ///< Temps de chaque coup (`RECORD_NO_TIME` : inconnu)
+  uint32_t count;      ///< Nombre de coups
+  uint32_t capacity;
+} GameRecord;
+
+/**
+ * @brief Crée une partie sans coup, non terminée.
+ *
+ * @param mode Le mode de jeu.
+ * @param dim La dimension du plateau.
+ * @param white Le joueur qui a les blancs et commence.
+ * @return GameRecord La partie, à libérer avec `free_game_record`.
+ */
+GameRecord init_game_record(GameMode mode, uint8_t dim, Player white);
+
+/**
+ * @brief Ajoute un coup à la fin de la partie.
+ *
+ * @param record Pointeur vers la partie.
+ * @param move Le coup joué.
+ * @param time_ms Le temps passé à le choisir, ou `RECORD_NO_TIME`.
+ */
+void record_move(GameRecord *record, Move move, uint32_t time_ms);
+
+/**
+ * @brief Issue de la partie arrivée à la position `state`.
+ *
+ * @param state Pointeur vers la position finale.
+ * @param white Le joueur qui a les blancs.
+ * @return RecordResult Le vainqueur selon `compare_scores`, ou
+ * `RecordUnfinished` si la partie n'est pas terminée : le joueur au trait
+ * a encore une pièce à poser sur une case légale.
+ */
+RecordResult result_of_game(const GameState *state, Player white);
+
+/**
+ * @brief Libère les coups d'une partie.
+ *
+ * @param record Pointeur vers la partie.
+ */
+void free_game_record(GameRecord *record);
+
+/**
+ * @brief Écrit une partie au format texte.
+ *
+ * Les coups sont répartis sur des lignes de moins de 80 caractères. Comme
+ * `snprintf`, renvoie la taille du texte ; si le tampon est trop petit
+ * (moins de `taille + 1` octets), le texte est tronqué mais toujours terminé
+ * par un zéro.
+ *
+ * @param record Pointeur vers la partie.
+ * @param out Tampon de destination.
+ * @param capacity Taille du tampon.
+ * @return size_t La taille du texte, sans le zéro final.
+ */
+size_t format_game_record(const GameRecord *record, char *out,
+                          size_t capacity);
+
+/**
+ * @brief Lit une partie au format texte et vérifie ses coups.
+ *
+ * Chaque coup est joué sur une position de travail : il doit appartenir au
+ * joueur au trait, qui doit encore avoir cette pièce, et la case doit être
+ * permise (`legal_squares_for`). Une partie lue peut donc être rejouée sans
+ * autre vérification. Le texte n'a pas besoin d'être terminé par un zéro et
+ * peut contenir plusieurs parties à la suite.
+ *
+ * @param text Le texte à lire.
+ * @param length Son nombre d'octets.
+ * @param record Reçoit la partie (à libérer avec `free_game_record` en cas
+ * de succès uniquement).
+ * @param offset Si non NULL, reçoit en cas de succès le nombre d'octets lus
+ * (début de la partie suivante), et en cas d'échec la position de l'octet
+ * fautif.
+ * @return DeserializeResult `DESERIALIZE_SUCCESS` ou la cause de l'échec
+ * (`DESERIALIZE_ILLEGAL_MOVE` pour un coup impossible).
+ */
+DeserializeResult parse_game_record(const char *text, size_t length,
+                                    GameRecord *record, size_t *offset);
+
+/**
+ * @brief Reconstruit la position après les `ply` premiers coups.
+ *
+ * Part du plateau vide et joue les coups avec `make_move`.
+ *
+ * @param record Pointeur vers la partie (lue par `parse_game_record` ou
+ * jouée).
+ * @param ply Nombre de coups à jouer, au plus `record->count`.
+ * @param state Reçoit la position, à libérer avec `free_game_state`.
+ * @return bool `false` si `ply` dépasse le nombre de coups.
+ */
+bool replay_game_record(const GameRecord *record, uint32_t ply,
+                        GameState *state);
+
+/**
+ * @brief Toutes les positions d'une partie, pour y naviguer librement.
+ *
+ * Chaque position est conservée à plat : l'état sans son plateau dans
+ * `states`, et ses cases à la suite dans `tiles` (`dim * dim` par
+ * position). Aller à un coup quelconque revient à recopier ces octets,
+ * quelques kilo-octets au plus.
+ */
+typedef struct {
+  uint32_t count; ///< Nombre de coups : positions 0 à `count`
+  uint8_t dim;
+  GameState *states; ///< `count + 1` états, `board.tiles` à NULL
+  Tile *tiles;
+} GameReplay;
+
+/**
+ * @brief Joue une fois toute la partie et garde chaque position.
+ *
+ * @param replay Pointeur vers le `GameReplay` à remplir.
+ * @param record Pointeur vers la partie.
+ */
+void init_game_replay(GameReplay *replay, const GameRecord *record);
+
+/**
+ * @brief Place dans `state` la position après `ply` coups.
+ *
+ * Aucune allocation : `state` doit déjà avoir un plateau de la même
+ * dimension (par exemple un premier `replay_game_record` ou
+ * `init_game_state_with`), dont les cases sont réécrites.
+ *
+ * @param replay Pointeur vers les positions de la partie.
+ * @param ply Le coup voulu, au plus `replay->count`.
+ * @param state Pointeur vers la position à remplacer.
+ */
+void seek_game_replay(const GameReplay *replay, uint32_t ply,
+                      GameState *state);
+
+/**
+ * @brief Libère les positions d'une partie.
+ *
+ * @param replay Pointeur vers le `GameReplay`.
+ */
+void free_game_replay(GameReplay *replay);
+
+#endif // GAME_RECORD_H
@@ -1,17 +1,38 @@
 #include "game_state.h"
 #include "board.h"
+#include "print.h"
+#include "render.h"
+#include "zobrist.h"
 #include <stdio.h>
 
 GameState init_game_state(const GameMode mode, const uint8_t dim) {
+  return init_game_state_with(mode, dim, random_player());
+}
+
+GameState init_game_state_with(const GameMode mode, const uint8_t dim,
+                               const Player first) {
+  init_zobrist_keys();
+
   GameState state;
   state.mode = mode;
   state.board = init_board(dim);
-  state.is_turn_of = state.is_white = random_player();
+  state.is_turn_of = state.is_white = first;
   state.piece_counter_1 = state.piece_counter_2 = init_piece_counter();
+  state.owned_occupied[User] = state.owned_occupied[Opponent] = 0;
+  state.owned_empty[User] = state.owned_empty[Opponent] = 0;
+  state.kinds_present[User] = state.kinds_present[Opponent] = 0;
+  state.hash = compute_hash(&state);
   return state;
 }
 
+GameState clone_game_state(const GameState *state) {
+  GameState copy = *state;
+  copy.board = copy_board(&state->board);
+  return copy;
+}
+
 void toggle_user_turn(GameState *state) {
+  state->hash ^= zobrist_opponent_turn_key;
   if (state->is_turn_of == User) {
     state->is_turn_of = Opponent;
   } else {
@@ -28,18 +49,152 @@ const PieceCountTracker *get_user_turn_count_tracker(const GameState *state) {
 }
 
 uint8_t get_captured_count_of(const GameState *state, const Player player) {
-  uint8_t count = 0;
+  return state->owned_occupied[player];
+}
+
+// Recalcule le masque des types présents d'un joueur à partir des bitboards
+static void refresh_kinds_present(GameState *state, const Player player) {
+  const BoardPlanes *planes = &state->board.planes;
+  const BitBoard owned =
+      bb_and(planes->by_player[player], planes->captured_by[player]);
+  uint8_t present = 0;
+
+  for (int kind = King; kind <= Pawn; kind++) {
+    if (!bb_is_empty(bb_and(owned, planes->by_kind[kind])))
+      present |= (uint8_t)(1u << kind);
+  }
+
+  state->kinds_present[player] = present;
+}
+
+bool consume_piece(GameState *state, const Player player,
+                   const PieceKind kind) {
+  PieceCountTracker *counter =
+      (player == User) ? &state->piece_counter_1 : &state->piece_counter_2;
+  const uint8_t count = get_piece_count(counter, kind);
+
+  if (!add_piece(counter, kind))
+    return false;
+
+  state->hash ^= zobrist_counter_key(player, kind, count) ^
+                 zobrist_counter_key(player, kind, count - 1);
+  return true;
+}
+
+void clear_piece_counters(GameState *state) {
+  state->hash ^= hash_piece_counter(User, &state->piece_counter_1) ^
+                 hash_piece_counter(Opponent, &state->piece_counter_2);
+  set_all_to_zero(&state->piece_counter_1);
+  set_all_to_zero(&state->piece_counter_2);
+  state->hash ^= hash_piece_counter(User, &state->piece_counter_1) ^
+                 hash_piece_counter(Opponent, &state->piece_counter_2);
+}
+
+bool has_kind_on_captured_tile(const GameState *state, const Player player,
+                               const PieceKind kind) {
+  return (state->kinds_present[player] >> kind) & 1;
+}
+
+int compare_scores(const GameState *state, const Player player) {
+  const Player other = (player == User) ? Opponent : User;
+  const int occupied = state->owned_occupied[player] - state->owned_occupied[other];
+
+  if (occupied != 0)
+    return occupied;
+  return state->owned_empty[player] - state->owned_empty[other];
+}
+
+void set_game_tile(GameState *state, const uint8_t x, const uint8_t y,
+                   const Tile tile) {
+  const Tile previous = state->board.tiles[y][x];
+
+  if (previous.captured_by.some) {
+    uint8_t *counter = previous.some ? state->owned_occupied : state->owned_empty;
+    counter[previous.captured_by.player]--;
+    state->hash ^= zobrist_owner_key(previous.captured_by.player, x, y);
+  }
+  if (tile.captured_by.some) {
+    uint8_t *counter = tile.some ? state->owned_occupied : state->owned_empty;
+    counter[tile.captured_by.player]++;
+    state->hash ^= zobrist_owner_key(tile.captured_by.player, x, y);
+  }
+  if (previous.some)
+    state->hash ^= zobrist_piece_key(previous.value.player, previous.value.kind, x, y);
+  if (tile.some)
+    state->hash ^= zobrist_piece_key(tile.value.player, tile.value.kind, x, y);
+
+  set_board_tile(&state->board, x, y, tile);
+
+  if (previous.some) {
+    // Une pièce disparaît (retour arrière) : cas rare, on recalcule
+    refresh_kinds_present(state, User);
+    refresh_kinds_present(state, Opponent);
+  } else if (tile.some && tile.captured_by.some &&
+             tile.captured_by.player == tile.value.player) {
+    state->kinds_present[tile.value.player] |= (uint8_t)(1u << tile.value.kind);
+  }
+}
+
+void capture_game_tiles(GameState *state, BitBoard mask, const Player owner) {
+  const BoardPlanes *planes = &state->board.planes;
+  const Player other = (owner == User) ? Opponent : User;
+
+  mask = bb_and(mask, planes->inside);
+  const BitBoard gained = bb_andnot(mask, planes->captured_by[owner]);
+  const BitBoard lost = bb_and(mask, planes->captured_by[other]);
+
+  const int gained_occupied = bb_popcount(bb_and(gained, planes->occupied));
+  const int lost_occupied = bb_popcount(bb_and(lost, planes->occupied));
+  state->owned_occupied[owner] += gained_occupied;
+  state->owned_empty[owner] += bb_popcount(gained) - gained_occupied;
+  state->owned_occupied[other] -= lost_occupied;
+  state->owned_empty[other] -= bb_popcount(lost) - lost_occupied;
+
+  // Seules les cases qui changent de propriétaire modifient la clé
+  BitBoard changed = gained;
+  uint8_t x, y;
+  while (bb_pop_square(&changed, &x, &y)) {
+    if (bb_test(&lost, x, y))
+      state->hash ^= zobrist_owner_key(other, x, y);
+    state->hash ^= zobrist_owner_key(owner, x, y);
+  }
+
+  capture_tiles(&state->board, mask, owner);
+
+  // Seul un changement de propriétaire d'une case occupée modifie les types
+  // présents ; les captures ordinaires ne touchent que des cases vides.
+  if (gained_occupied || lost_occupied) {
+    refresh_kinds_present(state, User);
+    refresh_kinds_present(state, Opponent);
+  }
+}
+
+bool check_capture_counters(const GameState *state) {
+  uint8_t occupied[2] = {0, 0};
+  uint8_t empty[2] = {0, 0};
+  uint8_t present[2] = {0, 0};
+
   for (uint8_t i = 0; i < state->board.dim; i++) {
     for (uint8_t j = 0; j < state->board.dim; j++) {
       const Tile tile = state->board.tiles[i][j];
-      if (tile.some && tile.captured_by.some &&
-          tile.captured_by.player == player) {
-        count++;
+      if (tile.captured_by.some) {
+        if (tile.some)
+          occupied[tile.captured_by.player]++;
+        else
+          empty[tile.captured_by.player]++;
+
+        if (tile.some && tile.value.player == tile.captured_by.player)
+          present[tile.value.player] |= (uint8_t)(1u << tile.value.kind);
       }
     }
   }
 
-  return count;
+  return occupied[User] == state->owned_occupied[User] &&
+         occupied[Opponent] == state->owned_occupied[Opponent] &&
+         empty[User] == state->owned_empty[User] &&
+         empty[Opponent] == state->owned_empty[Opponent] &&
+         present[User] == state->kinds_present[User] &&
+         present[Opponent] == state->kinds_present[Opponent];
 }
 
 /**
@@ -73,104 +228,10 @@ void debug_game_state(const GameState *state) {
 }
 
 void print_board(const GameState *state) {
-  const uint8_t dim = state->board.dim;
-
-  // ASCII digits for "1" and "2"
-  const char *digits[2][5] = {
-      {
-        "1111",
-        "  11",
-        "  11",
-        "  11",
-        "111111"
-      },
-      {
-        " 2222",
-        "22  22",
-        "   22",
-        "  22",
-       "222222"
-      }
-  };
-
-  const int player_index = (state->is_turn_of == User) ? 0 : 1;
-
-  printf("\n");
-  printf("      ");
-  for (uint8_t j = 0; j < dim; j++) {
-    printf("  %c  ", 'A' + j);
-    printf(" ");
-  }
-  printf("    <-- Joueur\n"); // Label
-
-  printf("\n");
-
-  for (uint8_t i = 0; i < dim; i++) {
-    for (int line = 0; line < 3; line++) {
-      if (line == 1) {
-        printf(" %2d  ", dim - i);
-      } else {
-        printf("     ");
-      }
-
-      for (uint8_t j = 0; j < dim; j++) {
-        const Tile tile = state->board.tiles[i][j];
-        AsciiPiece p = {"·····", "·····", "·····"};
-
-        if (tile.some) {
-          if (tile.value.player == User) {
-            p = piece_as_white_ascii(tile.value.kind);
-          } else {
-            p = piece_as_black_ascii(tile.value.kind);
-          }
-        }else if (tile.captured_by.some) {
-          if (tile.captured_by.player == User) {
-            p = (AsciiPiece) {"█████", "█████", "█████"};
-          } else {
-            p = (AsciiPiece) {"░░░░░", "░░░░░", "░░░░░"};
-          }
-        }
-
-        switch (line) {
-        case 0:
-          printf(" %s", p.line1);
-          break;
-        case 1:
-          printf(" %s", p.line2);
-          break;
-        case 2:
-          printf(" %s", p.line3);
-          break;
-        default:
-          break;
-        }
-      }
-
-      if (line == 1) {
-        printf("   %2d", dim - i);
-      }
-
-      // Display digit line - use sequential lines of the ASCII digit
-      int ascii_line = i * 3 + line;
-      if (ascii_line < 5) {
-        if (line != 1) {
-          printf("     ");
-        }
-        printf("    %s", digits[player_index][ascii_line]);
-      }
-
-      printf("\n");
-    }
-    printf("\n");
-  }
-
-  // Bottom letters
-  printf("      ");
-  for (uint8_t j = 0; j < dim; j++) {
-    printf("  %c  ", 'A' + j);
-    printf(" ");
-  }
-  printf("\n\n");
+  // Image complète du plateau, écrite en un seul appel système
+  static char frame[RENDER_FRAME_SIZE];
+  const size_t length = render_board(state, frame);
+  print_buffer(frame, length);
 }
 
 void free_game_state(const GameState *state) { free_board(&state->board); }
@@ -35,6 +35,11 @@ typedef struct {
       piece_counter_1; // Compteur de pièces disponibles pour le joueur 1
   PieceCountTracker
       piece_counter_2; // Compteur de pièces disponibles pour le joueur 2
+  uint8_t owned_occupied[2]; ///< Cases occupées capturées, par joueur
+  uint8_t owned_empty[2];    ///< Cases vides capturées, par joueur
+  uint8_t kinds_present[2];  ///< Bit `1 << kind` : le joueur a une pièce de ce
+                             ///< type sur une case qu'il a capturée
+  uint64_t hash; ///< Clé de Zobrist de la position (cf. `compute_hash`)
 } GameState;
 
 /**
@@ -49,12 +54,36 @@ typedef struct {
  */
 GameState init_game_state(GameMode mode, uint8_t dim);
 
+/**
+ * @brief Initialise un état de jeu dont le premier joueur est imposé.
+ *
+ * Même chose que `init_game_state`, sans tirage au sort par `rand()` : pour
+ * les parties reproductibles et les threads qui ont leur propre générateur.
+ * Le joueur qui commence joue les blancs.
+ *
+ * @param mode Le mode de jeu.
+ * @param dim La dimension du plateau.
+ * @param first Le joueur qui commence.
+ * @return GameState L'état de jeu initialisé.
+ */
+GameState init_game_state_with(GameMode mode, uint8_t dim, Player first);
+
+/**
+ * @brief Crée une copie indépendante d'un état de jeu.
+ *
+ * Le plateau est copié avec `copy_board` ; compteurs et clé sont repris tels
+ * quels.
+ *
+ * @param state Pointeur vers l'état de jeu à copier.
+ * @return GameState La copie, à libérer avec `free_game_state`.
+ */
+GameState clone_game_state(const GameState *state);
 
 /**
  * @brief Renvoie le nombre de pièces capturées par un joueur spécifique.
  *
- * Parcourt le plateau de jeu et compte les pièces capturées par le joueur
- * indiqué.
+ * Lit le compteur `owned_occupied`, tenu à jour à chaque changement de
+ * propriétaire d'une case : l'appel est en temps constant.
  *
  * @param state Pointeur vers l'état de jeu à inspecter.
  * @param player Le joueur dont on veut connaître le nombre de pièces capturées.
@@ -62,6 +91,92 @@ GameState init_game_state(GameMode mode, uint8_t dim);
  */
 uint8_t get_captured_count_of(const GameState *state, Player player);
 
+/**
+ * @brief Place une tuile sur le plateau en tenant à jour l'état de jeu.
+ *
+ * À utiliser à la place de `set_board_tile` dès que le plateau appartient à
+ * un `GameState`, afin que les compteurs de cases capturées restent exacts.
+ *
+ * @param state Pointeur vers l'état de jeu à modifier.
+ * @param x Colonne de la case.
+ * @param y Ligne de la case.
+ * @param tile La nouvelle tuile.
+ */
+void set_game_tile(GameState *state, uint8_t x, uint8_t y, Tile tile);
+
+/**
+ * @brief Attribue les cases d'un masque à un joueur en tenant à jour l'état de
+ * jeu.
+ *
+ * Les compteurs sont ajustés par comptage de bits sur le masque, sans
+ * parcourir le plateau.
+ *
+ * @param state Pointeur vers l'état de jeu à modifier.
+ * @param mask Les cases à capturer.
+ * @param owner Le joueur qui capture les cases.
+ */
+void capture_game_tiles(GameState *state, BitBoard mask, Player owner);
+
+/**
+ * @brief Consomme une pièce du compteur d'un joueur.
+ *
+ * Équivalent de `add_piece` sur le compteur du joueur, qui tient également à
+ * jour la clé de Zobrist de l'état.
+ *
+ * @param state Pointeur vers l'état de jeu à modifier.
+ * @param player Le joueur qui pose la pièce.
+ * @param kind Le type de pièce posée.
+ * @return bool `false` si le joueur n'a plus de pièce de ce type.
+ */
+bool consume_piece(GameState *state, Player player, PieceKind kind);
+
+/**
+ * @brief Vide les compteurs de pièces des deux joueurs (fin de partie).
+ *
+ * @param state Pointeur vers l'état de jeu à modifier.
+ */
+void clear_piece_counters(GameState *state);
+
+/**
+ * @brief Indique si un joueur a une pièce d'un type donné sur une case qu'il a
+ * capturée.
+ *
+ * Condition de la hiérarchie du mode Connect (Pion, Cavalier, Fou, Tour, Reine,
+ * Roi). Simple test de bit sur `kinds_present`.
+ *
+ * @param state Pointeur vers l'état de jeu.
+ * @param player Le joueur concerné.
+ * @param kind Le type de pièce recherché.
+ * @return bool `true` si une telle pièce existe.
+ */
+bool has_kind_on_captured_tile(const GameState *state, Player player,
+                               PieceKind kind);
+
+/**
+ * @brief Vérifie les compteurs de cases capturées par un recomptage complet.
+ *
+ * Parcourt la grille de tuiles et compare le résultat aux compteurs et aux
+ * masques `kinds_present` tenus à jour de façon incrémentale. Destinée aux
+ * vérifications en mode debug.
+ *
+ * @param state Pointeur vers l'état de jeu à inspecter.
+ * @return bool `true` si les compteurs sont exacts.
+ */
+bool check_capture_counters(const GameState *state);
+
+/**
+ * @brief Compare les scores des deux joueurs du point de vue de `player`.
+ *
+ * Le nombre de cases occupées capturées (`get_captured_count_of`) décide ; en
+ * cas d'égalité, les cases vides capturées départagent les joueurs. Utilisé
+ * par les moteurs pour juger une partie terminée.
+ *
+ * @param state Pointeur vers l'état de jeu.
+ * @param player Le joueur dont on prend le point de vue.
+ * @return int Positif si `player` mène, négatif s'il est mené, 0 sinon.
+ */
+int compare_scores(const GameState *state, Player player);
+
 /**
  * @brief Inverse le tour du joueur actif.
  *
@@ -97,7 +212,8 @@ const PieceCountTracker *get_user_turn_count_tracker(const GameState *state);
  *
  * Représente chaque pièce à l'aide d'un dessin ASCII, en distinguant les
  * joueurs. Ajoute les coordonnées comme dans une vraie partie d'échecs (lettres
- * et chiffres).
+ * et chiffres). L'image est préparée par `render_board` puis écrite d'un
+ * seul bloc.
  *
  * @param state Pointeur vers l'état de jeu contenant le plateau.
  */
@@ -0,0 +1,297 @@
+#include "journal.h"
+#include "move.h"
+#include <errno.h>
+#include <string.h>
+
+// Position des champs d'un enregistrement
+#define RECORD_KIND 0
+#define RECORD_X 1
+#define RECORD_Y 2
+#define RECORD_PLAYER 3
+#define RECORD_HASH 4 // 32 bits de poids faible, petit-boutiste
+
+static void write_u32(unsigned char *out, const uint32_t value) {
+  for (int i = 0; i < 4; ++i)
+    out[i] = (unsigned char)(value >> (8 * i));
+}
+
+static uint32_t read_u32(const unsigned char *in) {
+  return (uint32_t)in[0] | (uint32_t)in[1] << 8 | (uint32_t)in[2] << 16 |
+         (uint32_t)in[3] << 24;
+}
+
+static uint64_t read_u64(const unsigned char *in) {
+  return (uint64_t)read_u32(in) | (uint64_t)read_u32(in + 4) << 32;
+}
+
+#define JOURNAL_FRESH 4     // `middle` : sauvegarde pas encore prise
+#define JOURNAL_SLOT_MASK 3 // `middle` : numéro du tampon
+#define WRITER_POLL_MS 5    // Attente du thread d'écriture quand rien n'arrive
+
+/*
+ * Thread d'écriture
+ */
+
+static void report_error(Journal *journal, const int error) {
+  atomic_store_release_u32(&journal->error, error != 0 ? (uint32_t)error : EIO);
+}
+
+// Vide le journal : il ne contient plus que l'en-tête de la sauvegarde
+static void reset_log(Journal *journal, const uint64_t snapshot_hash) {
+  if (journal->file)
+    fclose(journal->file);
+  journal->file = fopen(JOURNAL_FILENAME, "wb");
+  if (!journal->file) {
+    report_error(journal, errno);
+    return;
+  }
+
+  unsigned char header[JOURNAL_HEADER_SIZE] = {0};
+  memcpy(header, JOURNAL_MAGIC, 4);
+  header[4] = JOURNAL_VERSION;
+  write_u32(header + 8, (uint32_t)snapshot_hash);
+  write_u32(header + 12, (uint32_t)(snapshot_hash >> 32));
+
+  if (fwrite(header, 1, sizeof(header), journal->file) != sizeof(header) ||
+      fflush(journal->file) != 0) {
+    report_error(journal, errno);
+    fclose(journal->file);
+    journal->file = NULL;
+  }
+}
+
+static void write_snapshot(Journal *journal, const JournalSnapshot *snapshot) {
+  // La sauvegarde d'abord : un arrêt entre les deux laisse un journal dont
+  // l'en-tête ne correspond plus, qui sera ignoré. Si elle échoue, l'ancien
+  // journal continue : sa relecture s'arrêtera aux coups manquants.
+  if (!write_save_file(JOURNAL_SAVE_FILENAME, snapshot->data,
+                       snapshot->size)) {
+    report_error(journal, errno);
+    return;
+  }
+  reset_log(journal, snapshot->hash);
+}
+
+static void append_record(Journal *journal, const unsigned char *record) {
+  if (!journal->file)
+    return; // erreur déjà signalée, en attendant la prochaine sauvegarde
+
+  if (fwrite(record, 1, JOURNAL_RECORD_SIZE, journal->file) !=
+          JOURNAL_RECORD_SIZE ||
+      fflush(journal->file) != 0) {
+    report_error(journal, errno);
+    fclose(journal->file);
+    journal->file = NULL;
+  }
+}
+
+static void run_journal_writer(void *arg) {
+  Journal *journal = arg;
+  uint64_t generation = 0; // sauvegarde à laquelle le journal fait suite
+
+  for (;;) {
+    // `closing` est lu avant le reste : s'il était levé et qu'il n'y a rien
+    // à écrire, plus rien ne peut arriver
+    const bool closing = atomic_load_acquire_u64(&journal->closing) != 0;
+
+    if (atomic_load_acquire_u32(&journal->middle) & JOURNAL_FRESH) {
+      journal->consumer_slot =
+          atomic_exchange_u32(&journal->middle, journal->consumer_slot) &
+          JOURNAL_SLOT_MASK;
+      const JournalSnapshot *snapshot =
+          &journal->snapshots[journal->consumer_slot];
+      write_snapshot(journal, snapshot);
+      generation = snapshot->generation;
+      atomic_store_release_u64(&journal->written_generation, generation);
+      continue;
+    }
+
+    const uint64_t tail = journal->tail;
+    if (tail != atomic_load_acquire_u64(&journal->head)) {
+      const JournalEntry *entry =
+          &journal->entries[tail & (JOURNAL_QUEUE_SIZE - 1)];
+      // Un coup qui suit une sauvegarde plus récente : celle-ci a été
+      // publiée avant lui, elle sera prise au tour suivant
+      if (entry->generation > generation)
+        continue;
+      // Les coups antérieurs à la sauvegarde écrite sont déjà dedans
+      if (entry->generation == generation)
+        append_record(journal, entry->data);
+      atomic_store_release_u64(&journal->tail, tail + 1);
+      continue;
+    }
+
+    if (closing)
+      break;
+    sleep_thread_ms(WRITER_POLL_MS);
+  }
+}
+
+/*
+ * Thread du jeu
+ */
+
+bool open_journal(Journal *journal, const GameState *state) {
+  memset(journal, 0, sizeof(Journal));
+  journal->producer_slot = 0;
+  journal->consumer_slot = 1;
+  journal->middle = 2;
+
+  if (!start_thread(&journal->thread, run_journal_writer, journal))
+    return false;
+  journal->active = true;
+
+  journal_snapshot(journal, state);
+  if (!journal_flush(journal)) {
+    close_journal(journal);
+    return false;
+  }
+  return true;
+}
+
+void journal_snapshot(Journal *journal, const GameState *state) {
+  if (!journal->active)
+    return;
+
+  JournalSnapshot *snapshot = &journal->snapshots[journal->producer_slot];
+  snapshot->generation = ++journal->generation;
+  snapshot->hash = state->hash;
+  snapshot->size = serialize_binary(state, snapshot->data);
+
+  // Récupère l'ancien tampon du milieu, pris ou non : une sauvegarde qui
+  // n'a pas encore été écrite est remplacée par celle-ci
+  journal->producer_slot =
+      atomic_exchange_u32(&journal->middle,
+                          journal->producer_slot | JOURNAL_FRESH) &
+      JOURNAL_SLOT_MASK;
+  journal->since_snapshot = 0;
+}
+
+void journal_move(Journal *journal, const GameState *state,
+                  const BitBoard occupied_before) {
+  if (!journal->active)
+    return;
+  if (++journal->since_snapshot >= JOURNAL_SNAPSHOT_INTERVAL) {
+    journal_snapshot(journal, state);
+    return;
+  }
+
+  BitBoard placed = bb_andnot(state->board.planes.occupied, occupied_before);
+  uint8_t x, y;
+  const uint64_t head = journal->head;
+  if (!bb_pop_square(&placed, &x, &y) || !bb_is_empty(placed) ||
+      head - atomic_load_acquire_u64(&journal->tail) == JOURNAL_QUEUE_SIZE) {
+    // Pas exactement une pièce posée, ou le disque ne suit pas : on repart
+    // d'une sauvegarde complète
+    journal_snapshot(journal, state);
+    return;
+  }
+
+  const ChessPiece piece = state->board.tiles[y][x].value;
+  JournalEntry *entry = &journal->entries[head & (JOURNAL_QUEUE_SIZE - 1)];
+  entry->generation = journal->generation;
+  entry->data[RECORD_KIND] = (unsigned char)piece.kind;
+  entry->data[RECORD_X] = x;
+  entry->data[RECORD_Y] = y;
+  entry->data[RECORD_PLAYER] = (unsigned char)piece.player;
+  write_u32(entry->data + RECORD_HASH, (uint32_t)state->hash);
+  atomic_store_release_u64(&journal->head, head + 1);
+}
+
+bool journal_flush(Journal *journal) {
+  if (!journal->active)
+    return false;
+
+  while (atomic_load_acquire_u64(&journal->written_generation) !=
+             journal->generation ||
+         atomic_load_acquire_u64(&journal->tail) != journal->head)
+    sleep_thread_ms(1);
+  return journal_take_error(journal) == 0;
+}
+
+int journal_take_error(Journal *journal) {
+  if (!journal->active)
+    return 0;
+  return (int)atomic_exchange_u32(&journal->error, 0);
+}
+
+void close_journal(Journal *journal) {
+  if (!journal->active)
+    return;
+
+  atomic_store_release_u64(&journal->closing, 1);
+  join_thread(journal->thread);
+  if (journal->file)
+    fclose(journal->file);
+  journal->file = NULL;
+  journal->active = false;
+}
+
+void discard_journal(Journal *journal) {
+  close_journal(journal);
+  remove(JOURNAL_FILENAME);
+  remove(JOURNAL_SAVE_FILENAME);
+}
+
+bool journal_exists(void) {
+  FILE *file = fopen(JOURNAL_SAVE_FILENAME, "rb");
+  if (!file)
+    return false;
+  fclose(file);
+  return true;
+}
+
+// Rejoue un enregistrement s'il est légal et redonne la même position
+static bool replay_record(GameState *state, const unsigned char *record) {
+  const uint8_t dim = state->board.dim;
+  const uint8_t kind = record[RECORD_KIND];
+  const uint8_t x = record[RECORD_X];
+  const uint8_t y = record[RECORD_Y];
+
+  if (kind > Pawn || x >= dim || y >= dim ||
+      record[RECORD_PLAYER] != state->is_turn_of ||
+      bb_test(&state->board.planes.occupied, x, y) ||
+      get_piece_count(get_user_turn_count_tracker(state), (PieceKind)kind) ==
+          0)
+    return false;
+
+  UndoRecord undo;
+  make_move(state, (Move){.kind = kind, .x = x, .y = y}, &undo);
+  if ((uint32_t)state->hash != read_u32(record + RECORD_HASH)) {
+    unmake_move(state, &undo);
+    return false;
+  }
+  return true;
+}
+
+DeserializeResult recover_game(GameState *state, uint32_t *replayed) {
+  if (replayed)
+    *replayed = 0;
+
+  const DeserializeResult result =
+      load_game_file(JOURNAL_SAVE_FILENAME, state);
+  if (result != DESERIALIZE_SUCCESS)
+    return result;
+
+  FILE *file = fopen(JOURNAL_FILENAME, "rb");
+  if (!file)
+    return DESERIALIZE_SUCCESS;
+
+  unsigned char header[JOURNAL_HEADER_SIZE];
+  if (fread(header, 1, sizeof(header), file) != sizeof(header) ||
+      memcmp(header, JOURNAL_MAGIC, 4) != 0 ||
+      header[4] != JOURNAL_VERSION || read_u64(header + 8) != state->hash) {
+    fclose(file);
+    return DESERIALIZE_SUCCESS;
+  }
+
+  unsigned char record[JOURNAL_RECORD_SIZE];
+  while (fread(record, 1, sizeof(record), file) == sizeof(record) &&
+         replay_record(state, record)) {
+    if (replayed)
+      ++*replayed;
+  }
+
+  fclose(file);
+  return DESERIALIZE_SUCCESS;
+}
@@ -0,0 +1,204 @@
+#ifndef JOURNAL_H
+#define JOURNAL_H
+#include "game_state.h"
+#include "save.h"
+#include "thread.h"
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+/// Sauvegarde complète de la partie en cours, distincte de `savegame.dat`
+#define JOURNAL_SAVE_FILENAME "autosave.dat"
+#define JOURNAL_FILENAME "autosave.log" ///< Coups joués depuis la sauvegarde
+#define JOURNAL_MAGIC "IF2J"            ///< Début de tout journal
+#define JOURNAL_VERSION 1
+#define JOURNAL_HEADER_SIZE 16 ///< Magie, version, clé de la sauvegarde
+#define JOURNAL_RECORD_SIZE 8  ///< Un coup : pièce, case, joueur, clé
+/// Nombre de coups entre deux sauvegardes complètes
+#define JOURNAL_SNAPSHOT_INTERVAL 16
+/// Coups en attente d'écriture au maximum (puissance de deux)
+#define JOURNAL_QUEUE_SIZE 64
+
+/**
+ * @brief Sauvegarde complète prête à être écrite (cf. `Journal`).
+ */
+typedef struct {
+  uint64_t generation; ///< Numéro de la demande de sauvegarde
+  uint64_t hash;       ///< Clé de Zobrist de la position
+  size_t size;
+  unsigned char data[SAVE_BINARY_MAX_SIZE]; ///< Format de `serialize_binary`
+} JournalSnapshot;
+
+/**
+ * @brief Coup en attente d'écriture, à la suite de la sauvegarde
+ * `generation`.
+ */
+typedef struct {
+  uint64_t generation;
+  unsigned char data[JOURNAL_RECORD_SIZE];
+} JournalEntry;
+
+/**
+ * @brief Sauvegarde automatique d'une partie en cours.
+ *
+ * La partie est conservée sous deux formes : `autosave.dat`, une sauvegarde
+ * complète au format de `serialize_binary`, et `autosave.log`, les coups
+ * joués depuis. Ces fichiers sont propres à la sauvegarde automatique :
+ * `savegame.dat`, que le joueur écrit en choisissant de sauvegarder, n'est
+ * jamais touché.
+ * Chaque coup ajoute un enregistrement de `JOURNAL_RECORD_SIZE` octets à la
+ * fin du journal ; tous les `JOURNAL_SNAPSHOT_INTERVAL` coups, la sauvegarde
+ * complète est réécrite (`write_save_file` : fichier temporaire, `fsync`,
+ * renommage) et le journal remis à zéro.
+ *
+ * L'en-tête du journal contient la clé de Zobrist de la sauvegarde à
+ * laquelle il fait suite, et chaque enregistrement la clé (32 bits de poids
+ * faible) obtenue après le coup. Un journal qui ne correspond pas à la
+ * sauvegarde (arrêt entre l'écriture de l'une et la remise à zéro de
+ * l'autre) est donc ignoré, et un enregistrement incomplet ou qui ne redonne
+ * pas la même position arrête la relecture.
+ *
+ * Les fichiers sont écrits par un thread dédié : le thread du jeu ne fait
+ * que copier quelques octets, sans jamais attendre le disque. Les
+ * sauvegardes complètes passent par un triple tampon (la plus récente
+ * remplace celle qui n'a pas encore été prise) et les coups par une file
+ * bornée à un producteur et un consommateur. Si la file est pleine parce
+ * que le disque ne suit pas, une sauvegarde complète est demandée à la
+ * place du coup : elle rend caducs tous les coups en attente.
+ */
+typedef struct {
+  // Triple tampon des sauvegardes complètes : le jeu remplit `snapshots
+  // [producer_slot]`, le thread d'écriture lit `snapshots[consumer_slot]`,
+  // `middle` désigne le troisième (bit `JOURNAL_FRESH` : pas encore pris)
+  JournalSnapshot snapshots[3];
+  uint32_t producer_slot;
+  uint32_t consumer_slot;
+  volatile uint32_t middle;
+
+  JournalEntry entries[JOURNAL_QUEUE_SIZE];
+  volatile uint64_t head; ///< Prochain coup déposé (thread du jeu)
+  volatile uint64_t tail; ///< Prochain coup écrit (thread d'écriture)
+
+  uint64_t generation;                 ///< Dernière sauvegarde demandée
+  volatile uint64_t written_generation; ///< Dernière sauvegarde traitée
+  volatile uint32_t error;   ///< `errno` du dernier échec, 0 sinon
+  volatile uint64_t closing; ///< Tout écrire puis arrêter le thread
+
+  FILE *file;              ///< Journal (thread d'écriture uniquement)
+  uint32_t since_snapshot; ///< Coups joués depuis la sauvegarde demandée
+  bool active;             ///< Thread lancé et premiers fichiers écrits
+  Thread thread;
+} Journal;
+
+/**
+ * @brief Commence la sauvegarde automatique d'une partie.
+ *
+ * Lance le thread d'écriture puis écrit une sauvegarde complète de `state`
+ * et un journal vide, en attendant qu'ils soient sur le disque. En cas
+ * d'échec, le journal est inactif et les autres fonctions ne font rien.
+ *
+ * @param journal Pointeur vers le journal à ouvrir.
+ * @param state Pointeur vers l'état de jeu.
+ * @return bool `false` si le thread n'a pas pu être lancé ou un des
+ * fichiers écrit.
+ */
+bool open_journal(Journal *journal, const GameState *state);
+
+/**
+ * @brief Ajoute au journal le coup qui vient d'être joué.
+ *
+ * Le coup est retrouvé sur le plateau : c'est la seule case occupée dans
+ * `state` qui ne l'était pas dans `occupied_before`. À appeler après avoir
+ * passé la main, une fois par coup. Tous les `JOURNAL_SNAPSHOT_INTERVAL`
+ * coups, demande une sauvegarde complète à la place (cf.
+ * `journal_snapshot`). Ne fait que déposer le coup : l'écriture a lieu
+ * dans le thread d'écriture.
+ *
+ * @param journal Pointeur vers le journal.
+ * @param state Pointeur vers l'état de jeu, coup joué.
+ * @param occupied_before Les cases occupées avant le coup.
+ */
+void journal_move(Journal *journal, const GameState *state,
+                  BitBoard occupied_before);
+
+/**
+ * @brief Demande une sauvegarde complète de `state` suivie d'un journal
+ * vide.
+ *
+ * La position est copiée au format binaire puis écrite par le thread
+ * d'écriture. Une demande qui n'a pas encore été prise en compte est
+ * remplacée par la nouvelle.
+ *
+ * @param journal Pointeur vers le journal.
+ * @param state Pointeur vers l'état de jeu.
+ */
+void journal_snapshot(Journal *journal, const GameState *state);
+
+/**
+ * @brief Attend que tout ce qui a été demandé soit écrit.
+ *
+ * @param journal Pointeur vers le journal.
+ * @return bool `false` si le journal est inactif ou si une écriture a
+ * échoué depuis le dernier `journal_take_error` (l'erreur est consommée).
+ */
+bool journal_flush(Journal *journal);
+
+/**
+ * @brief Renvoie l'erreur de la dernière écriture qui a échoué, une seule
+ * fois.
+ *
+ * À consulter par la boucle de jeu pour prévenir le joueur.
+ *
+ * @param journal Pointeur vers le journal.
+ * @return int La valeur de `errno` lors de l'échec, ou 0 si aucune écriture
+ * n'a échoué depuis l'appel précédent.
+ */
+int journal_take_error(Journal *journal);
+
+/**
+ * @brief Écrit ce qui est en attente, arrête le thread et ferme le journal
+ * en laissant les fichiers en place.
+ *
+ * @param journal Pointeur vers le journal.
+ */
+void close_journal(Journal *journal);
+
+/**
+ * @brief Ferme le journal et supprime la sauvegarde automatique et le
+ * journal.
+ *
+ * À appeler quand la partie est terminée ou sauvegardée par le joueur : il
+ * n'y a plus rien à reprendre.
+ *
+ * @param journal Pointeur vers le journal.
+ */
+void discard_journal(Journal *journal);
+
+/**
+ * @brief Indique s'il reste une sauvegarde automatique à reprendre.
+ *
+ * C'est le cas après un arrêt brutal : une partie terminée, abandonnée ou
+ * sauvegardée par le joueur supprime la sienne (`discard_journal`).
+ *
+ * @return bool `true` si `autosave.dat` existe.
+ */
+bool journal_exists(void);
+
+/**
+ * @brief Reprend une partie : charge la sauvegarde automatique puis rejoue
+ * le journal.
+ *
+ * Chaque coup est rejoué avec `make_move`, qui pose la pièce et applique ses
+ * captures (`apply_conquest_capture`) exactement comme pendant la partie. La
+ * relecture s'arrête au premier enregistrement incomplet, illégal ou dont la
+ * clé ne correspond pas à la position obtenue. Un journal absent ou qui ne
+ * fait pas suite à la sauvegarde n'est pas une erreur.
+ *
+ * @param state Pointeur vers l'état à remplir (à libérer avec
+ * `free_game_state` en cas de succès uniquement).
+ * @param replayed Si non NULL, reçoit le nombre de coups rejoués.
+ * @return DeserializeResult Le résultat du chargement de la sauvegarde.
+ */
+DeserializeResult recover_game(GameState *state, uint32_t *replayed);
+
+#endif // JOURNAL_H
@@ -1,14 +1,76 @@
+#include "attack.h"
+#include "bench.h"
 #include "game_state.h"
+#include "journal.h"
 #include "print.h"
+#include "protocol.h"
+#include "render.h"
 #include "save.h"
 #include "select.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <time.h>
 #include "capture.h"
+#include "mcts.h"
+#include "search.h"
+#include "thread.h"
+#include "zobrist.h"
+#include <string.h>
+
+// Options de la ligne de commande
+typedef struct {
+  uint32_t threads;            // Threads des moteurs
+  MctsParallelism parallelism; // Répartition de la recherche Monte Carlo
+  bool bench;                  // Lancer le banc d'essai au lieu d'une partie
+  bool engine;                 // Piloter le jeu par le protocole texte
+} Arguments;
+
+static bool parse_arguments(const int argc, char **argv, Arguments *args) {
+  args->threads = hardware_thread_count();
+  args->parallelism = MctsTreeParallel;
+  args->bench = false;
+  args->engine = false;
+
+  for (int i = 1; i < argc; ++i) {
+    if (strcmp(argv[i], "--bench") == 0) {
+      args->bench = true;
+    } else if (strcmp(argv[i], "--engine") == 0) {
+      args->engine = true;
+    } else if (strcmp(argv[i], "--mcts-root") == 0) {
+      args->parallelism = MctsRootParallel;
+    } else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+      const int threads = atoi(argv[++i]);
+      if (threads < 1)
+        return false;
+      args->threads = (uint32_t)threads;
+    } else {
+      return false;
+    }
+  }
+  return true;
+}
+
+int main(const int argc, char **argv) {
+  Arguments args;
+  if (!parse_arguments(argc, argv, &args)) {
+    fprintf(stderr, "Usage : %s [--threads N] [--mcts-root] [--bench | --engine]\n", argv[0]);
+    return 1;
+  }
 
-int main(void) {
   srand(time(0));
+  init_attack_tables();
+  init_zobrist_keys();
+
+  if (args.bench) {
+    run_benchmark(args.threads, BENCH_DEFAULT_TIME_MS);
+    return 0;
+  }
+  if (args.engine) {
+    const ProtocolOptions options = {.threads = args.threads,
+                                     .parallelism = args.parallelism};
+    return run_engine_protocol(stdin, stdout, options);
+  }
+
   print_title_screen();
 
   const StartOption option = select_option();
@@ -33,13 +95,36 @@ int main(void) {
     break;
   }
   case Restart: {
-    if (!save_file_exists()) {
+    // une partie interrompue brutalement passe avant la sauvegarde du joueur
+    const bool interrupted = journal_exists();
+    if (!interrupted && !save_file_exists()) {
       print_effect("Aucune partie sauvegardée trouvée.\n", 50);
       return 0;
     }
 
     printf("Chargement de la partie...\n");
-    game_state = load_game();
+    // sauvegarde automatique puis coups du journal joués depuis
+    DeserializeResult result =
+        interrupted ? recover_game(&game_state, NULL)
+                    : load_game_file(SAVE_FILENAME, &game_state);
+    if (interrupted && result != DESERIALIZE_SUCCESS) {
+      // illisible une fois, illisible toujours : on l'efface pour ne plus
+      // masquer la sauvegarde du joueur
+      printf("Partie interrompue illisible (%s), abandonnée.\n",
+             deserialize_error_message(result));
+      remove(JOURNAL_FILENAME);
+      remove(JOURNAL_SAVE_FILENAME);
+      if (!save_file_exists()) {
+        print_effect("Aucune partie sauvegardée trouvée.\n", 50);
+        return 0;
+      }
+      result = load_game_file(SAVE_FILENAME, &game_state);
+    }
+    if (result != DESERIALIZE_SUCCESS) {
+      printf("Erreur de désérialisation : %s\n",
+             deserialize_error_message(result));
+      return 1;
+    }
     sleep_ms(750);
     clear_screen();
     print_text("Partie chargée!\n");
@@ -54,6 +139,27 @@ int main(void) {
     return 1;
   }
 
+  const OpponentKind opponent = select_opponent();
+  clear_screen();
+
+  SearchLimits engine_limits = {.max_depth = SEARCH_MAX_PLY - 1,
+                                .threads = args.threads};
+  TranspositionTable tt = {.entries = NULL};
+  MctsTree mcts_tree = {.nodes = NULL};
+  if (opponent != Human) {
+    engine_limits.time_limit_ms = select_engine_time();
+    clear_screen();
+  }
+  if (opponent == AlphaBetaEngine) {
+    tt = init_tt(TT_DEFAULT_SIZE_MB);
+    engine_limits.tt = &tt;
+  }
+  const MctsLimits mcts_limits = {.time_limit_ms = engine_limits.time_limit_ms,
+                                  .threads = args.threads,
+                                  .parallelism = args.parallelism};
+  if (opponent == MctsEngine)
+    mcts_tree = init_mcts_tree(MCTS_DEFAULT_CAPACITY, (uint64_t)time(0));
+
   if (game_state.is_white == User) {
     print_text("Vous êtes les blancs!\n");
   } else {
@@ -64,16 +170,45 @@ int main(void) {
   clear_screen();
   sleep_ms(200);
 
+  // chaque coup est ajouté au journal : un arrêt brutal ne perd qu'un coup
+  Journal journal;
+  if (!open_journal(&journal, &game_state))
+    printf("La sauvegarde automatique est désactivée.\n");
+
   bool game_stopped = false;
+  bool game_over = false; // plus aucun coup possible, la partie se compte
+  bool save_failed = false;
+  ScreenRenderer screen;
+  init_screen_renderer(&screen);
 
-  while (!game_stopped &&
+  while (!game_stopped && !game_over &&
          !has_no_pieces_left(get_user_turn_count_tracker(&game_state))) {
-    // pour centrer le titre
-    for (int i = 0; i < game_state.board.dim / 2 + 1; i++) {
-      printf("   ");
-    }
+    // seules les cases modifiées depuis le tour précédent sont redessinées
+    draw_board(&screen, &game_state);
+    const BitBoard occupied = game_state.board.planes.occupied;
+
+    // les fichiers sont écrits en arrière-plan : les échecs arrivent ici
+    const int save_error = journal_take_error(&journal);
+    if (save_error != 0)
+      printf("Échec de la sauvegarde automatique : %s\n", strerror(save_error));
 
-    print_board(&game_state);
+    if (opponent != Human && game_state.is_turn_of == Opponent) {
+      const bool played =
+          opponent == MctsEngine
+              ? play_mcts_turn(&game_state, &mcts_tree, mcts_limits)
+              : play_engine_turn(&game_state, engine_limits);
+      if (!played) {
+        printf("L'ordinateur ne peut plus poser de pièce. Partie terminée!\n");
+        sleep_ms(1500);
+        game_over = true;
+        break;
+      }
+
+      sleep_ms(1500);
+      toggle_user_turn(&game_state);
+      journal_move(&journal, &game_state, occupied);
+      continue;
+    }
 
     const RoundOption round_option = select_round_option();
 
@@ -96,7 +231,7 @@ int main(void) {
       }
 
       toggle_user_turn(&game_state);
-      clear_screen();
+      journal_move(&journal, &game_state, occupied);
       break;
     }
     case GiveUp: {
@@ -107,6 +242,7 @@ int main(void) {
     }
     case SaveGame: {
       const bool success = save_game(&game_state);
+      release_screen(&screen);
 
       if (!success) {
         printf("Une erreur est survenue, nous n'avons pas pu sauvegarder la "
@@ -118,11 +254,31 @@ int main(void) {
       print_text("La partie a été sauvegardée avec succès.\n");
       sleep_ms(400);
       game_stopped = true;
+      save_failed = !success;
+      break;
+    }
+    case Redraw: {
+      // le tour reste le même : le plateau est réaffiché en entier
+      invalidate_screen(&screen);
       break;
     }
     }
   }
 
+  release_screen(&screen);
+
+  // une partie terminée ou sauvegardée n'a plus rien à reprendre ; si la
+  // sauvegarde a échoué, la sauvegarde automatique reste seule
+  if (save_failed)
+    close_journal(&journal);
+  else
+    discard_journal(&journal);
+
+  if (mcts_tree.nodes != NULL)
+    free_mcts_tree(&mcts_tree);
+  if (tt.entries != NULL)
+    free_tt(&tt);
+
   if (game_stopped) {
     clear_screen();
     sleep_ms(500);
@@ -132,22 +288,30 @@ int main(void) {
 
   const PieceCountTracker *current_tracker =
       get_user_turn_count_tracker(&game_state);
-  if (has_no_pieces_left(current_tracker)) {
+  if (game_over || has_no_pieces_left(current_tracker)) {
     clear_screen();
     sleep_ms(500);
-    print_text("Toutes les pièces ont été jouées.\n");
+    if (!game_over)
+      print_text("Toutes les pièces ont été jouées.\n");
     print_text("La partie est terminée!\n");
+    // Même règle que les moteurs : cases occupées, puis cases vides
     const uint8_t user_count = get_captured_count_of(&game_state, User);
     const uint8_t opponent_count = get_captured_count_of(&game_state, Opponent);
+    const uint8_t user_empty = game_state.owned_empty[User];
+    const uint8_t opponent_empty = game_state.owned_empty[Opponent];
+    const int score = compare_scores(&game_state, User);
 
-    if (user_count > opponent_count) {
-      printf("Victoire de l'utilisateur ! (%d cases contre %d)\n", user_count,
-             opponent_count);
-    } else if (opponent_count > user_count) {
-      printf("Victoire de l'adversaire ! (%d cases contre %d)\n",
-             opponent_count, user_count);
+    if (score > 0) {
+      printf("Victoire de l'utilisateur ! (%d cases occupées et %d vides "
+             "contre %d et %d)\n",
+             user_count, user_empty, opponent_count, opponent_empty);
+    } else if (score < 0) {
+      printf("Victoire de l'adversaire ! (%d cases occupées et %d vides "
+             "contre %d et %d)\n",
+             opponent_count, opponent_empty, user_count, user_empty);
     } else {
-      printf("Égalité parfaite : %d cases chacun !\n", user_count);
+      printf("Égalité parfaite : %d cases occupées et %d vides chacun !\n",
+             user_count, user_empty);
     }
   }
 
@@ -0,0 +1,411 @@
+#include "match.h"
+#include "attack.h"
+#include "movegen.h"
+#include "pool.h"
+#include "save.h"
+#include "thread.h"
+#include "timer.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define MATCH_MAX_PLIES 64 ///< Une partie dure au plus 16 poses par joueur
+#define MATCH_REPORT_MS 1000
+// Plancher de la variance d'une paire : sans lui, des paires toutes égales
+// (moteurs identiques) donneraient une variance nulle et un rapport infini
+#define MATCH_MIN_VARIANCE 1e-3
+// Paires à jouer avant d'autoriser l'arrêt : sur quelques paires, la
+// variance estimée n'a pas de sens
+#define MATCH_MIN_PAIRS 20
+// Score maximal retenu pour la conversion en Elo (environ 1200 points)
+#define MATCH_MAX_SCORE 0.999
+
+enum { Win, Draw, Loss };
+
+typedef struct {
+  const MatchOptions *options;
+  GameState *openings;
+  uint32_t opening_count;
+  Engine *engines; // Deux moteurs par thread : A puis B
+  double lower;    // Bornes du rapport de vraisemblance
+  double upper;
+  // Nombre de paires par score du moteur A, en demi-points (0 à 4)
+  volatile uint64_t pair_counts[5];
+  // Parties par mode, dimension et résultat du moteur A
+  volatile uint64_t games[2][ATTACK_DIM_COUNT][3];
+  volatile uint64_t stop;     // Le test a conclu : plus de nouvelle paire
+  volatile uint64_t finished; // Toutes les paires sont jouées
+} MatchContext;
+
+// Score moyen d'une partie et variance du score d'une paire (ramené à une
+// partie), calculés sur les compteurs de paires
+typedef struct {
+  uint64_t pairs;
+  double score;
+  double variance;
+} PairStats;
+
+static PairStats pair_stats(const MatchContext *context) {
+  PairStats stats = {0};
+  double sum = 0.0, squares = 0.0;
+
+  for (int k = 0; k < 5; ++k) {
+    const uint64_t count = atomic_load_u64(&context->pair_counts[k]);
+    const double score = k / 4.0;
+    stats.pairs += count;
+    sum += (double)count * score;
+    squares += (double)count * score * score;
+  }
+  if (stats.pairs == 0)
+    return stats;
+
+  stats.score = sum / (double)stats.pairs;
+  stats.variance = squares / (double)stats.pairs - stats.score * stats.score;
+  return stats;
+}
+
+// Score attendu face à un adversaire plus faible de `elo` points
+static double elo_to_score(const double elo) {
+  return 1.0 / (1.0 + pow(10.0, -elo / 400.0));
+}
+
+static double score_to_elo(double score) {
+  if (score > MATCH_MAX_SCORE)
+    score = MATCH_MAX_SCORE;
+  if (score < 1.0 - MATCH_MAX_SCORE)
+    score = 1.0 - MATCH_MAX_SCORE;
+  return -400.0 * log10(1.0 / score - 1.0);
+}
+
+// Logarithme du rapport de vraisemblance H1 / H0, approximation normale
+static double log_likelihood_ratio(const PairStats *stats,
+                                   const MatchOptions *options) {
+  if (stats->pairs == 0)
+    return 0.0;
+
+  const double variance = stats->variance > MATCH_MIN_VARIANCE
+                              ? stats->variance
+                              : MATCH_MIN_VARIANCE;
+  const double score0 = elo_to_score(options->elo0);
+  const double score1 = elo_to_score(options->elo1);
+  const double d0 = stats->score - score0;
+  const double d1 = stats->score - score1;
+
+  return (double)stats->pairs * (d0 * d0 - d1 * d1) / (2.0 * variance);
+}
+
+// Demi-largeur de l'intervalle de confiance à 95 % sur l'Elo
+static void elo_interval(const PairStats *stats, double *elo,
+                         double *margin) {
+  *elo = score_to_elo(stats->score);
+  *margin = 0.0;
+  if (stats->pairs == 0)
+    return;
+
+  const double error = 1.96 * sqrt(stats->variance / (double)stats->pairs);
+  *margin = (score_to_elo(stats->score + error) -
+             score_to_elo(stats->score - error)) /
+            2.0;
+}
+
+// Lit toutes les positions d'un fichier : chacune commence par `mode=`
+static bool load_openings(const char *path, GameState **openings,
+                          uint32_t *count) {
+  FILE *file = fopen(path, "rb");
+  if (!file) {
+    perror("Impossible d'ouvrir le fichier d'ouvertures");
+    return false;
+  }
+
+  fseek(file, 0, SEEK_END);
+  const long size = ftell(file);
+  fseek(file, 0, SEEK_SET);
+  char *text = malloc((size_t)(size > 0 ? size : 0) + 1);
+  if (!text) {
+    perror("Failed to allocate memory for the openings");
+    exit(EXIT_FAILURE);
+  }
+  const size_t length = fread(text, 1, (size_t)(size > 0 ? size : 0), file);
+  text[length] = '\0';
+  fclose(file);
+
+  uint32_t capacity = 16;
+  *openings = malloc(capacity * sizeof(GameState));
+  *count = 0;
+  if (!*openings) {
+    perror("Failed to allocate memory for the openings");
+    exit(EXIT_FAILURE);
+  }
+
+  const char *record = strstr(text, "mode=");
+  while (record) {
+    // La position s'arrête au début de la suivante
+    const char *next = strstr(record + 5, "\nmode=");
+    if (next)
+      next++;
+    const size_t record_length =
+        next ? (size_t)(next - record) : strlen(record);
+
+    GameState state;
+    size_t offset = 0;
+    const DeserializeResult result =
+        parse_game_text(record, record_length, &state, &offset);
+    if (result != DESERIALIZE_SUCCESS) {
+      fprintf(stderr, "%s, position %u (octet %zu) : %s\n", path, *count + 1,
+              (size_t)(record - text) + offset,
+              deserialize_error_message(result));
+      for (uint32_t i = 0; i < *count; ++i)
+        free_game_state(&(*openings)[i]);
+      free(*openings);
+      free(text);
+      return false;
+    }
+
+    if (*count == capacity) {
+      capacity *= 2;
+      *openings = realloc(*openings, capacity * sizeof(GameState));
+      if (!*openings) {
+        perror("Failed to allocate memory for the openings");
+        exit(EXIT_FAILURE);
+      }
+    }
+    (*openings)[(*count)++] = state;
+    record = next;
+  }
+
+  free(text);
+  if (*count == 0) {
+    fprintf(stderr, "%s : aucune position\n", path);
+    free(*openings);
+    return false;
+  }
+  return true;
+}
+
+// Sans fichier : un plateau vide par dimension et par mode
+static void default_openings(GameState **openings, uint32_t *count) {
+  *count = 2 * ATTACK_DIM_COUNT;
+  *openings = malloc(*count * sizeof(GameState));
+  if (!*openings) {
+    perror("Failed to allocate memory for the openings");
+    exit(EXIT_FAILURE);
+  }
+
+  for (uint32_t i = 0; i < *count; ++i) {
+    const GameMode mode = i % 2 ? Connect : Conquest;
+    const uint8_t dim = (uint8_t)(ATTACK_MIN_DIM + i / 2);
+    (*openings)[i] = init_game_state_with(mode, dim, User);
+  }
+}
+
+// Joue une partie ; renvoie le résultat du moteur A, qui joue `a_player`
+static int play_game(Engine *a, Engine *b, const GameState *opening,
+                     const Player a_player, Rng *rng) {
+  GameState state = clone_game_state(opening);
+  reset_engine(a, rng_next(rng));
+  reset_engine(b, rng_next(rng));
+
+  for (int ply = 0; ply < MATCH_MAX_PLIES && !is_game_over(&state); ++ply) {
+    Engine *engine = state.is_turn_of == a_player ? a : b;
+    Move move;
+    if (!engine_choose_move(engine, &state, &move))
+      break;
+
+    UndoRecord undo;
+    make_move(&state, move, &undo);
+  }
+
+  const int score = compare_scores(&state, a_player);
+  free_game_state(&state);
+  return score > 0 ? Win : score < 0 ? Loss : Draw;
+}
+
+static void play_pair(void *arg, const uint32_t worker, const uint32_t index) {
+  MatchContext *context = arg;
+  if (atomic_load_acquire_u64(&context->stop))
+    return;
+
+  const MatchOptions *options = context->options;
+  Engine *a = &context->engines[2 * worker];
+  Engine *b = &context->engines[2 * worker + 1];
+
+  // La paire ne dépend que de la graine du match et de son numéro
+  Rng rng = init_rng(options->seed ^ (0x9E3779B97F4A7C15ULL * (index + 1)));
+  GameState opening =
+      clone_game_state(&context->openings[index % context->opening_count]);
+  for (uint32_t ply = 0; ply < options->random_plies && !is_game_over(&opening);
+       ++ply) {
+    Move move;
+    if (!pick_random_move(&opening, &rng, &move))
+      break;
+    UndoRecord undo;
+    make_move(&opening, move, &undo);
+  }
+
+  const int first = play_game(a, b, &opening, User, &rng);
+  const int second = play_game(a, b, &opening, Opponent, &rng);
+
+  const int mode = opening.mode == Connect;
+  const int dim = opening.board.dim - ATTACK_MIN_DIM;
+  free_game_state(&opening);
+
+  atomic_add_u64(&context->games[mode][dim][first], 1);
+  atomic_add_u64(&context->games[mode][dim][second], 1);
+  // Win = 0, Draw = 1, Loss = 2 : le score de la paire vaut 4 - first - second
+  atomic_add_u64(&context->pair_counts[4 - first - second], 1);
+
+  const PairStats stats = pair_stats(context);
+  const double llr = log_likelihood_ratio(&stats, options);
+  if (stats.pairs >= MATCH_MIN_PAIRS &&
+      (llr <= context->lower || llr >= context->upper))
+    atomic_store_release_u64(&context->stop, 1);
+}
+
+static void run_pairs(void *arg) {
+  MatchContext *context = arg;
+  parallel_for(context->options->threads, context->options->pairs, play_pair,
+               context);
+  atomic_store_release_u64(&context->finished, 1);
+}
+
+// Parties gagnées, nulles et perdues par le moteur A, tous modes confondus
+static void total_games(const MatchContext *context, uint64_t totals[3]) {
+  totals[Win] = totals[Draw] = totals[Loss] = 0;
+  for (int mode = 0; mode < 2; ++mode) {
+    for (int dim = 0; dim < ATTACK_DIM_COUNT; ++dim) {
+      for (int result = 0; result < 3; ++result)
+        totals[result] += atomic_load_u64(&context->games[mode][dim][result]);
+    }
+  }
+}
+
+static void report_progress(const MatchContext *context) {
+  const PairStats stats = pair_stats(context);
+  uint64_t totals[3];
+  total_games(context, totals);
+  double elo, margin;
+  elo_interval(&stats, &elo, &margin);
+
+  fprintf(stderr,
+          "\r%llu paires, +%llu =%llu -%llu, Elo %+.1f +/- %.1f, LLR %.2f "
+          "[%.2f, %.2f]  ",
+          (unsigned long long)stats.pairs, (unsigned long long)totals[Win],
+          (unsigned long long)totals[Draw], (unsigned long long)totals[Loss],
+          elo, margin, log_likelihood_ratio(&stats, context->options),
+          context->lower, context->upper);
+}
+
+static void print_summary(const MatchContext *context) {
+  const MatchOptions *options = context->options;
+  const PairStats stats = pair_stats(context);
+  uint64_t totals[3];
+  total_games(context, totals);
+  double elo, margin;
+  elo_interval(&stats, &elo, &margin);
+  const double llr = log_likelihood_ratio(&stats, options);
+
+  char description[128];
+  format_engine_config(&options->engines[0], description, sizeof(description));
+  printf("Moteur A : %s\n", description);
+  format_engine_config(&options->engines[1], description, sizeof(description));
+  printf("Moteur B : %s\n", description);
+
+  printf("Paires : %llu, parties : +%llu =%llu -%llu, score %.1f %%\n",
+         (unsigned long long)stats.pairs, (unsigned long long)totals[Win],
+         (unsigned long long)totals[Draw], (unsigned long long)totals[Loss],
+         100.0 * stats.score);
+  printf("Score des paires (0 à 2 points) :");
+  for (int k = 0; k < 5; ++k)
+    printf(" %llu", (unsigned long long)atomic_load_u64(&context->pair_counts[k]));
+  printf("\n");
+  printf("Elo : %+.1f +/- %.1f (95 %%)\n", elo, margin);
+  printf("SPRT elo0=%.1f elo1=%.1f alpha=%.3f beta=%.3f : LLR %.2f "
+         "[%.2f, %.2f], %s\n",
+         options->elo0, options->elo1, options->alpha, options->beta, llr,
+         context->lower, context->upper,
+         llr >= context->upper   ? "H1 acceptée"
+         : llr <= context->lower ? "H0 acceptée"
+                                 : "aucune conclusion");
+
+  printf("\n%-9s %4s %7s %7s %7s %7s\n", "mode", "dim", "+", "=", "-",
+         "score");
+  for (int mode = 0; mode < 2; ++mode) {
+    for (int dim = 0; dim < ATTACK_DIM_COUNT; ++dim) {
+      const volatile uint64_t *games = context->games[mode][dim];
+      const uint64_t win = atomic_load_u64(&games[Win]);
+      const uint64_t draw = atomic_load_u64(&games[Draw]);
+      const uint64_t loss = atomic_load_u64(&games[Loss]);
+      const uint64_t played = win + draw + loss;
+      if (played == 0)
+        continue;
+
+      printf("%-9s %4d %7llu %7llu %7llu %6.1f%%\n",
+             mode ? "Connect" : "Conquest", dim + ATTACK_MIN_DIM,
+             (unsigned long long)win, (unsigned long long)draw,
+             (unsigned long long)loss,
+             100.0 * ((double)win + 0.5 * (double)draw) / (double)played);
+    }
+  }
+}
+
+int run_match(const MatchOptions *options) {
+  MatchContext context = {.options = options};
+  const uint32_t threads = options->threads > 0 ? options->threads : 1;
+
+  if (options->openings) {
+    if (!load_openings(options->openings, &context.openings,
+                       &context.opening_count))
+      return 1;
+  } else {
+    default_openings(&context.openings, &context.opening_count);
+  }
+
+  context.lower = log(options->beta / (1.0 - options->alpha));
+  context.upper = log((1.0 - options->beta) / options->alpha);
+
+  context.engines = malloc(2 * threads * sizeof(Engine));
+  if (context.engines == NULL) {
+    perror("Failed to allocate memory for the engines");
+    exit(EXIT_FAILURE);
+  }
+  for (uint32_t i = 0; i < threads; ++i) {
+    context.engines[2 * i] = init_engine(options->engines[0], options->seed + i);
+    context.engines[2 * i + 1] =
+        init_engine(options->engines[1], options->seed + i);
+  }
+
+  fprintf(stderr, "%u paires au plus, %u ouvertures, %u threads, graine %llu\n",
+          options->pairs, context.opening_count, threads,
+          (unsigned long long)options->seed);
+
+  // Les paires sont jouées par un autre thread : celui-ci affiche la
+  // progression
+  Thread pairs_thread;
+  if (!start_thread(&pairs_thread, run_pairs, &context)) {
+    perror("Impossible de créer le thread des parties");
+    return 1;
+  }
+  const uint64_t start_ms = now_ms();
+  uint64_t next_report_ms = MATCH_REPORT_MS;
+  while (!atomic_load_acquire_u64(&context.finished)) {
+    sleep_thread_ms(50);
+    if (now_ms() - start_ms >= next_report_ms) {
+      report_progress(&context);
+      next_report_ms += MATCH_REPORT_MS;
+    }
+  }
+  join_thread(pairs_thread);
+  report_progress(&context);
+  fprintf(stderr, "\n");
+
+  print_summary(&context);
+
+  for (uint32_t i = 0; i < 2 * threads; ++i)
+    free_engine(&context.engines[i]);
+  free(context.engines);
+  for (uint32_t i = 0; i < context.opening_count; ++i)
+    free_game_state(&context.openings[i]);
+  free(context.openings);
+  return 0;
+}
@@ -0,0 +1,53 @@
+#ifndef MATCH_H
+#define MATCH_H
+#include "engine.h"
+
+/**
+ * @brief Réglages d'un match entre deux moteurs.
+ *
+ * Le test séquentiel (SPRT) oppose deux hypothèses sur l'écart d'Elo entre le
+ * moteur A et le moteur B : H0 `elo = elo0` et H1 `elo = elo1`. `alpha` et
+ * `beta` sont les risques d'accepter H1 à tort et H0 à tort.
+ */
+typedef struct {
+  EngineConfig engines[2]; ///< Moteur A (testé) et moteur B (référence)
+  uint32_t pairs;          ///< Nombre maximal de paires de parties
+  uint32_t threads;        ///< Paires jouées en même temps
+  uint64_t seed;           ///< Graine du match
+  const char *openings;    ///< Fichier de positions (NULL : plateaux vides)
+  uint32_t random_plies;   ///< Coups joués au hasard après l'ouverture
+  double elo0;             ///< Écart d'Elo de H0
+  double elo1;             ///< Écart d'Elo de H1
+  double alpha;            ///< Risque de première espèce
+  double beta;             ///< Risque de seconde espèce
+} MatchOptions;
+
+/**
+ * @brief Fait jouer deux moteurs l'un contre l'autre jusqu'à ce que le SPRT
+ * conclue ou que toutes les paires soient jouées.
+ *
+ * Chaque paire part de la même ouverture : une position du fichier
+ * `openings` (au format de `savegame.dat`, plusieurs positions à la suite),
+ * ou à défaut un plateau vide pour chaque dimension (6 à 12) et chaque mode,
+ * suivie de `random_plies` coups tirés au hasard. Dans la première partie le
+ * moteur A joue `User`, dans la seconde `Opponent` : l'avantage du trait et
+ * de l'ouverture s'annule sur la paire.
+ *
+ * Les deux parties d'une paire étant corrélées, le test porte sur le score
+ * de la paire (distribution à cinq valeurs, de 0 à 2 points) et non sur
+ * chaque partie. Le rapport de vraisemblance est calculé avec
+ * l'approximation normale du SPRT généralisé ; le match s'arrête dès qu'il
+ * sort de [log(beta / (1 - alpha)), log((1 - beta) / alpha)], après au moins
+ * quelques dizaines de parties. Les paires déjà commencées sont terminées et
+ * comptées.
+ *
+ * La progression (score, Elo, rapport de vraisemblance) est affichée sur la
+ * sortie d'erreur ; le bilan final, avec l'Elo et son intervalle de confiance
+ * à 95 % et le détail par mode et par dimension, sur la sortie standard.
+ *
+ * @param options Les réglages du match.
+ * @return int Code de sortie du programme.
+ */
+int run_match(const MatchOptions *options);
+
+#endif // MATCH_H
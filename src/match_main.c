@@ -0,0 +1,89 @@
+#include "attack.h"
+#include "match.h"
+#include "thread.h"
+#include "zobrist.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static void print_usage(const char *program) {
+  fprintf(stderr,
+          "Usage : %s --engine-a SPEC --engine-b SPEC [--pairs N]\n"
+          "          [--threads N] [--seed S] [--openings FICHIER]\n"
+          "          [--random-plies N] [--elo0 E] [--elo1 E]\n"
+          "          [--alpha A] [--beta B]\n"
+          "SPEC : alphabeta[:depth=D] ou mcts[:playouts=P], cf. engine.h\n"
+          "FICHIER : positions au format de savegame.dat, à la suite\n",
+          program);
+}
+
+static bool parse_arguments(const int argc, char **argv,
+                            MatchOptions *options) {
+  *options = (MatchOptions){.pairs = 10000,
+                            .threads = hardware_thread_count(),
+                            .seed = 1,
+                            .random_plies = 2,
+                            .elo0 = 0.0,
+                            .elo1 = 10.0,
+                            .alpha = 0.05,
+                            .beta = 0.05};
+  bool engines[2] = {false, false};
+
+  for (int i = 1; i + 1 < argc; i += 2) {
+    const char *name = argv[i];
+    const char *value = argv[i + 1];
+
+    if (strcmp(name, "--engine-a") == 0) {
+      engines[0] = parse_engine_config(value, &options->engines[0]);
+      if (!engines[0])
+        return false;
+    } else if (strcmp(name, "--engine-b") == 0) {
+      engines[1] = parse_engine_config(value, &options->engines[1]);
+      if (!engines[1])
+        return false;
+    } else if (strcmp(name, "--pairs") == 0) {
+      options->pairs = (uint32_t)strtoul(value, NULL, 10);
+    } else if (strcmp(name, "--threads") == 0) {
+      options->threads = (uint32_t)strtoul(value, NULL, 10);
+      if (options->threads == 0)
+        return false;
+    } else if (strcmp(name, "--seed") == 0) {
+      options->seed = strtoull(value, NULL, 10);
+    } else if (strcmp(name, "--openings") == 0) {
+      options->openings = value;
+    } else if (strcmp(name, "--random-plies") == 0) {
+      options->random_plies = (uint32_t)strtoul(value, NULL, 10);
+    } else if (strcmp(name, "--elo0") == 0) {
+      options->elo0 = strtod(value, NULL);
+    } else if (strcmp(name, "--elo1") == 0) {
+      options->elo1 = strtod(value, NULL);
+    } else if (strcmp(name, "--alpha") == 0) {
+      options->alpha = strtod(value, NULL);
+    } else if (strcmp(name, "--beta") == 0) {
+      options->beta = strtod(value, NULL);
+    } else {
+      return false;
+    }
+  }
+
+  // Arguments en nombre impair : une option sans valeur
+  if (argc % 2 == 0)
+    return false;
+  return engines[0] && engines[1] && options->alpha > 0.0 &&
+         options->alpha < 1.0 && options->beta > 0.0 && options->beta < 1.0 &&
+         options->elo0 < options->elo1;
+}
+
+int main(const int argc, char **argv) {
+  MatchOptions options;
+  if (!parse_arguments(argc, argv, &options)) {
+    print_usage(argv[0]);
+    return 1;
+  }
+
+  // Tables partagées : calculées avant de lancer les threads
+  init_attack_tables();
+  init_zobrist_keys();
+
+  return run_match(&options);
+}
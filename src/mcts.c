@@ -0,0 +1,492 @@
+#include "mcts.h"
+#include "capture.h"
+#include "movegen.h"
+#include "search.h"
+#include "thread.h"
+#include "timer.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define MCTS_UNEXPANDED UINT32_MAX   ///< `legal_count` pas encore calculé
+#define MCTS_EXPLORATION 1.41421356f ///< Constante UCT (racine de 2)
+#define MCTS_VIRTUAL_LOSS 3 ///< Défaites comptées pendant une simulation
+// Nombre premier supérieur à MAX_MOVES : toujours premier avec le nombre de
+// coups, il parcourt tous les indices une seule fois.
+#define MCTS_ORDER_STRIDE 7919u
+// Une partie dure au plus 16 poses par joueur
+#define MCTS_MAX_PLY 64
+// Réserve minimale d'un arbre temporaire en parallélisme à la racine
+#define MCTS_MIN_HELPER_CAPACITY (1u << 14)
+
+// Recherche en cours, commune à tous les threads
+typedef struct {
+  MctsLimits limits;
+  uint64_t start_ms;
+  volatile uint32_t playouts; // Simulations commencées, tous threads confondus
+} MctsShared;
+
+// Données propres à un thread de recherche
+typedef struct {
+  MctsTree *tree;
+  GameState *state;
+  Rng rng;
+  uint32_t virtual_loss; // 0 si le thread est seul sur son arbre
+  uint32_t playouts;     // Simulations effectuées par ce thread
+  MctsShared *shared;
+  MctsTree own_tree;   // Arbre temporaire (parallélisme à la racine)
+  GameState own_state; // Copie de l'état (threads auxiliaires)
+  Thread thread;
+  bool running;
+} MctsWorker;
+
+static MctsNode *allocate_nodes(const uint32_t capacity) {
+  MctsNode *nodes = malloc(sizeof(MctsNode) * capacity);
+  if (nodes == NULL) {
+    perror("Failed to allocate memory for the search tree");
+    exit(EXIT_FAILURE);
+  }
+  return nodes;
+}
+
+MctsTree init_mcts_tree(const uint32_t capacity, const uint64_t seed) {
+  MctsTree tree = {.capacity = capacity, .root = MCTS_NO_NODE};
+  tree.nodes = allocate_nodes(capacity);
+  tree.rng = init_rng(seed);
+  return tree;
+}
+
+void free_mcts_tree(MctsTree *tree) {
+  free(tree->nodes);
+  tree->nodes = NULL;
+  tree->capacity = tree->count = 0;
+  tree->root = MCTS_NO_NODE;
+}
+
+// Réserve un nœud ; renvoie MCTS_NO_NODE si la réserve est pleine. Plusieurs
+// threads peuvent réserver en même temps : `count` peut alors dépasser
+// `capacity`, ce que les lectures de `count` doivent prendre en compte.
+static uint32_t new_node(MctsTree *tree, const uint64_t hash, const Move move,
+                         const uint8_t mover) {
+  const uint32_t index = atomic_add_u32(&tree->count, 1);
+  if (index >= tree->capacity)
+    return MCTS_NO_NODE;
+
+  tree->nodes[index] = (MctsNode){.hash = hash,
+                                  .first_child = MCTS_NO_NODE,
+                                  .next_sibling = MCTS_NO_NODE,
+                                  .legal_count = MCTS_UNEXPANDED,
+                                  .move = move,
+                                  .mover = mover};
+  return index;
+}
+
+// Recopie le sous-arbre de `root` au début d'une nouvelle réserve, en largeur
+// d'abord, et libère l'ancienne.
+static void compact_tree(MctsTree *tree, const uint32_t root) {
+  MctsNode *old = tree->nodes;
+  MctsNode *nodes = allocate_nodes(tree->capacity);
+
+  nodes[0] = old[root];
+  uint32_t count = 1;
+
+  // Les enfants d'un nœud sont recopiés à la suite, dans le même ordre
+  for (uint32_t i = 0; i < count; ++i) {
+    uint32_t child = nodes[i].first_child;
+    uint32_t *link = &nodes[i].first_child;
+    while (child != MCTS_NO_NODE) {
+      nodes[count] = old[child];
+      *link = count;
+      link = &nodes[count].next_sibling;
+      child = old[child].next_sibling;
+      count++;
+    }
+    *link = MCTS_NO_NODE;
+  }
+
+  free(old);
+  tree->nodes = nodes;
+  tree->count = count;
+  tree->root = 0;
+}
+
+// Cherche la position actuelle parmi la racine et ses descendants sur deux
+// demi-coups : coup joué par le moteur, puis réponse de l'adversaire.
+static uint32_t find_reusable_root(const MctsTree *tree, const uint64_t hash) {
+  const uint32_t root = tree->root;
+  if (root == MCTS_NO_NODE)
+    return MCTS_NO_NODE;
+  if (tree->nodes[root].hash == hash)
+    return root;
+
+  for (uint32_t c = tree->nodes[root].first_child; c != MCTS_NO_NODE;
+       c = tree->nodes[c].next_sibling) {
+    if (tree->nodes[c].hash == hash)
+      return c;
+    for (uint32_t g = tree->nodes[c].first_child; g != MCTS_NO_NODE;
+         g = tree->nodes[g].next_sibling) {
+      if (tree->nodes[g].hash == hash)
+        return g;
+    }
+  }
+  return MCTS_NO_NODE;
+}
+
+static void prepare_root(MctsTree *tree, const GameState *state) {
+  const uint32_t root = find_reusable_root(tree, state->hash);
+
+  if (root == MCTS_NO_NODE) {
+    const Player previous = state->is_turn_of == User ? Opponent : User;
+    tree->count = 0;
+    tree->root =
+        new_node(tree, state->hash, (Move){.kind = 0xFF}, (uint8_t)previous);
+    return;
+  }
+
+  tree->root = root;
+  if (tree->count > tree->capacity)
+    tree->count = tree->capacity;
+  // Libère la place occupée par les branches abandonnées
+  if (tree->count > tree->capacity / 2)
+    compact_tree(tree, root);
+}
+
+static void lock_node(MctsNode *node) {
+  while (atomic_exchange_u32(&node->lock, 1) != 0) {
+  }
+}
+
+static void unlock_node(MctsNode *node) {
+  atomic_store_release_u32(&node->lock, 0);
+}
+
+// Nombre de coups du nœud, à appeler verrou pris. Il est calculé à la
+// première visite pour ne pas générer les coups des feuilles jamais revues.
+static uint32_t legal_count_of(MctsNode *node, const GameState *state) {
+  if (node->legal_count == MCTS_UNEXPANDED) {
+    Move moves[MAX_MOVES];
+    const uint32_t count =
+        is_game_over(state) ? 0 : (uint32_t)generate_moves(state, moves);
+    atomic_store_release_u32(&node->legal_count, count);
+  }
+  return node->legal_count;
+}
+
+// Ajoute l'enfant suivant de `index` si possible et le joue. Les coups sont
+// créés dans un ordre pseudo-aléatoire propre à la position pour ne pas
+// favoriser un type de pièce. Renvoie MCTS_NO_NODE si le nœud est terminal,
+// déjà entièrement développé ou si la réserve est pleine.
+static uint32_t try_expand(MctsTree *tree, const uint32_t index,
+                           GameState *state, UndoRecord *undo) {
+  MctsNode *node = &tree->nodes[index];
+  uint32_t child = MCTS_NO_NODE;
+
+  lock_node(node);
+  const uint32_t legal = legal_count_of(node, state);
+  if (node->child_count < legal) {
+    Move moves[MAX_MOVES];
+    const size_t count = generate_moves(state, moves);
+    const uint32_t offset = (uint32_t)(node->hash % count);
+    const Move move =
+        moves[(offset + (uint64_t)node->child_count * MCTS_ORDER_STRIDE) %
+              count];
+    const uint8_t mover = (uint8_t)state->is_turn_of;
+
+    make_move(state, move, undo);
+    child = new_node(tree, state->hash, move, mover);
+    if (child == MCTS_NO_NODE) {
+      unmake_move(state, undo);
+    } else {
+      // Le nouvel enfant est ajouté en tête de liste, une fois initialisé
+      tree->nodes[child].next_sibling = node->first_child;
+      atomic_store_release_u32(&node->first_child, child);
+      atomic_store_release_u32(&node->child_count, node->child_count + 1);
+    }
+  }
+  unlock_node(node);
+  return child;
+}
+
+static uint32_t select_uct(const MctsTree *tree, const uint32_t index) {
+  const MctsNode *node = &tree->nodes[index];
+  const float log_visits = logf((float)atomic_load_u32(&node->visits) + 1.0f);
+  uint32_t best = MCTS_NO_NODE;
+  float best_score = -1.0f;
+
+  for (uint32_t c = atomic_load_acquire_u32(&node->first_child);
+       c != MCTS_NO_NODE; c = tree->nodes[c].next_sibling) {
+    const MctsNode *child = &tree->nodes[c];
+    const uint32_t visits = atomic_load_u32(&child->visits);
+    // Enfant créé par un autre thread et pas encore visité : à essayer
+    if (visits == 0)
+      return c;
+
+    const float n = (float)visits;
+    const float score = (float)atomic_load_u32(&child->wins) / (2.0f * n) +
+                        MCTS_EXPLORATION * sqrtf(log_visits / n);
+    if (score > best_score) {
+      best_score = score;
+      best = c;
+    }
+  }
+  return best;
+}
+
+// Termine la partie au hasard puis restaure l'état. Renvoie le vainqueur
+// selon `compare_scores`, ou -1 en cas d'égalité parfaite.
+static int random_playout(GameState *state, Rng *rng) {
+  UndoRecord undo[MCTS_MAX_PLY];
+  int ply = 0;
+  Move move;
+
+  while (ply < MCTS_MAX_PLY && !is_game_over(state) &&
+         pick_random_move(state, rng, &move)) {
+    make_move(state, move, &undo[ply++]);
+  }
+
+  const int score = compare_scores(state, User);
+  while (ply > 0)
+    unmake_move(state, &undo[--ply]);
+
+  if (score > 0)
+    return User;
+  if (score < 0)
+    return Opponent;
+  return -1;
+}
+
+static void run_iteration(MctsWorker *worker) {
+  MctsTree *tree = worker->tree;
+  GameState *state = worker->state;
+  const uint32_t virtual_loss = worker->virtual_loss;
+  UndoRecord undo[MCTS_MAX_PLY];
+  uint32_t path[MCTS_MAX_PLY + 1];
+  int depth = 0;
+
+  uint32_t index = tree->root;
+  path[0] = index;
+  atomic_add_u32(&tree->nodes[index].visits, virtual_loss);
+
+  while (depth < MCTS_MAX_PLY) {
+    MctsNode *node = &tree->nodes[index];
+    const uint32_t legal = atomic_load_acquire_u32(&node->legal_count);
+    if (legal == 0)
+      break;
+
+    uint32_t next = MCTS_NO_NODE;
+    bool expanded = false;
+    if (legal == MCTS_UNEXPANDED ||
+        atomic_load_acquire_u32(&node->child_count) < legal) {
+      next = try_expand(tree, index, state, &undo[depth]);
+      expanded = next != MCTS_NO_NODE;
+    }
+    // Déjà développé par un autre thread, ou réserve pleine
+    if (!expanded) {
+      if (atomic_load_acquire_u32(&node->child_count) < legal ||
+          atomic_load_acquire_u32(&node->first_child) == MCTS_NO_NODE)
+        break;
+      next = select_uct(tree, index);
+      make_move(state, tree->nodes[next].move, &undo[depth]);
+    }
+
+    index = next;
+    path[++depth] = index;
+    atomic_add_u32(&tree->nodes[index].visits, virtual_loss);
+    if (expanded)
+      break;
+  }
+
+  const int winner = random_playout(state, &worker->rng);
+
+  // Remplace la perte virtuelle par le résultat réel
+  for (int i = depth; i >= 0; --i) {
+    MctsNode *node = &tree->nodes[path[i]];
+    atomic_add_u32(&node->visits, 1u - virtual_loss);
+    if (winner < 0)
+      atomic_add_u32(&node->wins, 1);
+    else if (winner == node->mover)
+      atomic_add_u32(&node->wins, 2);
+  }
+
+  while (depth > 0)
+    unmake_move(state, &undo[--depth]);
+}
+
+static bool should_stop(MctsWorker *worker) {
+  MctsShared *shared = worker->shared;
+  const MctsLimits *limits = &shared->limits;
+
+  if (limits->playouts != 0 &&
+      atomic_add_u32(&shared->playouts, 1) >= limits->playouts)
+    return true;
+  // L'horloge n'est consultée que toutes les 64 simulations du thread
+  return limits->time_limit_ms != 0 && (worker->playouts & 63) == 0 &&
+         now_ms() - shared->start_ms >= limits->time_limit_ms;
+}
+
+static void run_worker(void *arg) {
+  MctsWorker *worker = arg;
+  while (!should_stop(worker)) {
+    run_iteration(worker);
+    worker->playouts++;
+  }
+}
+
+// Indice d'un coup parmi les MAX_MOVES coups possibles (type, case)
+static int move_slot(const Move move) {
+  return (move.kind * BITBOARD_MAX_DIM + move.y) * BITBOARD_MAX_DIM + move.x;
+}
+
+// Additionne les visites et victoires des coups de la racine de `tree`
+static void merge_root(const MctsTree *tree, uint32_t *visits,
+                       uint32_t *wins) {
+  for (uint32_t c = tree->nodes[tree->root].first_child; c != MCTS_NO_NODE;
+       c = tree->nodes[c].next_sibling) {
+    const MctsNode *child = &tree->nodes[c];
+    const int slot = move_slot(child->move);
+    visits[slot] += child->visits;
+    wins[slot] += child->wins;
+  }
+}
+
+MctsResult mcts_search(MctsTree *tree, GameState *state, MctsLimits limits) {
+  MctsResult result = {.found = false};
+
+  if (limits.playouts == 0 && limits.time_limit_ms == 0)
+    limits.playouts = MCTS_DEFAULT_PLAYOUTS;
+  const uint32_t thread_count = limits.threads > 1 ? limits.threads : 1;
+  const bool root_parallel = limits.parallelism == MctsRootParallel;
+
+  MctsShared shared = {.limits = limits, .start_ms = now_ms()};
+
+  prepare_root(tree, state);
+  result.reused_visits = tree->nodes[tree->root].visits;
+
+  MctsNode *root = &tree->nodes[tree->root];
+  const uint32_t legal = legal_count_of(root, state);
+  if (legal == 0)
+    return result;
+
+  MctsWorker *workers = calloc(thread_count, sizeof(MctsWorker));
+  if (workers == NULL) {
+    perror("Failed to allocate memory for search threads");
+    exit(EXIT_FAILURE);
+  }
+
+  for (uint32_t i = 0; i < thread_count; ++i) {
+    MctsWorker *worker = &workers[i];
+    worker->shared = &shared;
+    worker->rng = init_rng(rng_next(&tree->rng));
+    worker->tree = tree;
+    worker->state = state;
+    if (i == 0)
+      continue;
+
+    worker->own_state = clone_game_state(state);
+    worker->state = &worker->own_state;
+    if (root_parallel) {
+      uint32_t capacity = tree->capacity / thread_count;
+      if (capacity < MCTS_MIN_HELPER_CAPACITY)
+        capacity = MCTS_MIN_HELPER_CAPACITY;
+      worker->own_tree = init_mcts_tree(capacity, 0);
+      prepare_root(&worker->own_tree, state);
+      worker->tree = &worker->own_tree;
+    } else {
+      workers[0].virtual_loss = worker->virtual_loss = MCTS_VIRTUAL_LOSS;
+    }
+  }
+
+  for (uint32_t i = 1; i < thread_count; ++i)
+    workers[i].running = start_thread(&workers[i].thread, run_worker,
+                                      &workers[i]);
+  run_worker(&workers[0]);
+
+  // Visites et demi-points par coup (type, case), tous arbres confondus
+  uint32_t visits[MAX_MOVES] = {0};
+  uint32_t wins[MAX_MOVES] = {0};
+
+  for (uint32_t i = 0; i < thread_count; ++i) {
+    MctsWorker *worker = &workers[i];
+    if (i > 0 && worker->running)
+      join_thread(worker->thread);
+    result.playouts += worker->playouts;
+
+    if (i == 0 || root_parallel)
+      merge_root(worker->tree, visits, wins);
+    if (i > 0) {
+      if (root_parallel)
+        free_mcts_tree(&worker->own_tree);
+      free_game_state(&worker->own_state);
+    }
+  }
+  free(workers);
+
+  // Le coup le plus visité est le plus fiable. Avec moins de deux visites
+  // par coup, les visites ne départagent rien et le taux de gain décide ;
+  // il départage aussi les visites égales. Les égalités restantes sont
+  // tirées au sort : l'ordre des cases favoriserait le roi et les premières
+  // cases
+  uint64_t total_visits = 0;
+  for (int slot = 0; slot < MAX_MOVES; ++slot)
+    total_visits += visits[slot];
+  const bool by_win_rate = total_visits < 2 * (uint64_t)legal;
+
+  int best_slot = -1;
+  uint32_t ties = 0;
+  for (int slot = 0; slot < MAX_MOVES; ++slot) {
+    if (visits[slot] == 0)
+      continue;
+    int order = 1;
+    if (best_slot >= 0) {
+      // wins / visits comparés sans division
+      const uint64_t rate = (uint64_t)wins[slot] * visits[best_slot];
+      const uint64_t best_rate = (uint64_t)wins[best_slot] * visits[slot];
+      const int by_rate = (rate > best_rate) - (rate < best_rate);
+      const int by_visits = (visits[slot] > visits[best_slot]) -
+                            (visits[slot] < visits[best_slot]);
+      order = by_win_rate || by_visits == 0 ? by_rate : by_visits;
+    }
+    if (order > 0) {
+      best_slot = slot;
+      ties = 1;
+    } else if (order == 0 && rng_below(&tree->rng, ++ties) == 0) {
+      best_slot = slot;
+    }
+  }
+  if (best_slot >= 0) {
+    const int squares = BITBOARD_MAX_DIM * BITBOARD_MAX_DIM;
+    const int square = best_slot % squares;
+    result.found = true;
+    result.best_move = (Move){.kind = (uint8_t)(best_slot / squares),
+                              .x = (uint8_t)(square % BITBOARD_MAX_DIM),
+                              .y = (uint8_t)(square / BITBOARD_MAX_DIM)};
+    result.win_rate =
+        (float)wins[best_slot] / (2.0f * (float)visits[best_slot]);
+  }
+
+  if (tree->count > tree->capacity)
+    tree->count = tree->capacity;
+  result.time_ms = now_ms() - shared.start_ms;
+  return result;
+}
+
+bool play_mcts_turn(GameState *state, MctsTree *tree, const MctsLimits limits) {
+  const MctsResult result = mcts_search(tree, state, limits);
+  if (!result.found)
+    return false;
+
+  const Move move = result.best_move;
+  char position[4];
+  format_position(state->board.dim, move.x, move.y, position);
+  printf("L'ordinateur pose %s en %s (%u simulations, %.0f%% de victoires).\n",
+         stringify_piece((PieceKind)move.kind), position, result.playouts,
+         result.win_rate * 100.0f);
+
+  place_piece(state, (PieceKind)move.kind, move.x, move.y);
+
+  if (state->mode == Connect && move.kind == King) {
+    printf("Le roi a été placé par le joueur %s. La partie est terminée !\n",
+           stringify_player(state->is_turn_of));
+  }
+  return true;
+}
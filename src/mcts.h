@@ -0,0 +1,132 @@
+#ifndef MCTS_H
+#define MCTS_H
+#include "move.h"
+#include "rng.h"
+
+#define MCTS_NO_NODE UINT32_MAX
+#define MCTS_DEFAULT_CAPACITY (1u << 19) ///< ~20 Mo de nœuds
+#define MCTS_DEFAULT_PLAYOUTS 20000 ///< Budget utilisé si aucune limite n'est donnée
+
+/**
+ * @brief Nœud de l'arbre de recherche Monte Carlo.
+ *
+ * Les enfants sont créés un par un, dans un ordre pseudo-aléatoire dérivé de
+ * la clé de la position, et chaînés par `next_sibling`. En recherche
+ * parallèle sur un arbre commun, les statistiques sont mises à jour par des
+ * additions atomiques et la création d'un enfant est protégée par `lock`.
+ */
+typedef struct {
+  uint64_t hash;         ///< Clé de Zobrist de la position du nœud
+  uint32_t first_child;  ///< Dernier enfant créé (`MCTS_NO_NODE` si aucun)
+  uint32_t next_sibling; ///< Enfant suivant du même parent
+  uint32_t visits;       ///< Simulations passées par ce nœud (et pertes
+                         ///< virtuelles des simulations en cours)
+  uint32_t wins;         ///< Demi-points du point de vue de `mover` :
+                         ///< 2 par victoire, 1 par égalité
+  uint32_t child_count;  ///< Nombre d'enfants déjà créés
+  uint32_t legal_count;  ///< Nombre de coups légaux (calculé à la 1re visite)
+  uint32_t lock;         ///< Verrou de création des enfants
+  Move move;             ///< Coup menant à ce nœud
+  uint8_t mover;         ///< Joueur ayant joué `move` (`Player`)
+} MctsNode;
+
+/**
+ * @brief Arbre de recherche conservé d'un tour à l'autre.
+ *
+ * Les nœuds sont pris dans un tableau alloué une seule fois. Au tour suivant,
+ * le sous-arbre correspondant à la nouvelle position devient la racine.
+ */
+typedef struct {
+  MctsNode *nodes;   ///< Réserve de nœuds
+  uint32_t capacity; ///< Taille de la réserve
+  uint32_t count;    ///< Nœuds utilisés
+  uint32_t root;     ///< Racine actuelle (`MCTS_NO_NODE` si l'arbre est vide)
+  Rng rng;           ///< Graines des threads, tirage des égalités à la racine
+} MctsTree;
+
+/**
+ * @brief Répartition d'une recherche Monte Carlo sur plusieurs threads.
+ */
+typedef enum {
+  MctsTreeParallel, ///< Un seul arbre commun, avec pertes virtuelles
+  MctsRootParallel  ///< Un arbre par thread, visites fusionnées à la racine
+} MctsParallelism;
+
+/**
+ * @brief Limites d'une recherche Monte Carlo.
+ *
+ * Si les deux limites valent 0, `MCTS_DEFAULT_PLAYOUTS` simulations sont
+ * effectuées. Le nombre de simulations est un total pour tous les threads.
+ */
+typedef struct {
+  uint32_t playouts;           ///< Nombre maximal de simulations (0 : illimité)
+  uint32_t time_limit_ms;      ///< Temps de réflexion maximal (0 : illimité)
+  uint32_t threads;            ///< Nombre de threads (0 ou 1 : thread appelant)
+  MctsParallelism parallelism; ///< Répartition entre les threads
+} MctsLimits;
+
+/**
+ * @brief Résultat d'une recherche Monte Carlo.
+ */
+typedef struct {
+  bool found;             ///< `false` si le joueur n'a aucun coup légal
+  Move best_move;         ///< Coup le plus visité (cf. `mcts_search`)
+  float win_rate;         ///< Taux de victoire estimé de ce coup
+  uint32_t playouts;      ///< Simulations effectuées pendant cette recherche
+  uint32_t reused_visits; ///< Simulations héritées des tours précédents
+  uint64_t time_ms;       ///< Durée de la recherche
+} MctsResult;
+
+/**
+ * @brief Alloue un arbre vide.
+ *
+ * @param capacity Nombre maximal de nœuds.
+ * @param seed Graine du générateur des simulations.
+ * @return MctsTree L'arbre initialisé.
+ */
+MctsTree init_mcts_tree(uint32_t capacity, uint64_t seed);
+
+/**
+ * @brief Libère la mémoire d'un arbre.
+ *
+ * @param tree Pointeur vers l'arbre à libérer.
+ */
+void free_mcts_tree(MctsTree *tree);
+
+/**
+ * @brief Cherche un coup par recherche arborescente Monte Carlo (UCT).
+ *
+ * Chaque itération descend dans l'arbre selon la formule UCT, ajoute un
+ * enfant, puis termine la partie au hasard (`pick_random_move`) jusqu'à ce que
+ * `has_no_pieces_left` ou l'absence de coup légal y mette fin. Le résultat est
+ * jugé avec `compare_scores`. Si la position est déjà dans l'arbre (coup
+ * précédent et réponse de l'adversaire), son sous-arbre est réutilisé.
+ *
+ * Avec plusieurs threads, chacun travaille sur sa copie de l'état avec son
+ * propre générateur. `MctsTreeParallel` partage l'arbre : chaque nœud traversé
+ * reçoit une perte virtuelle jusqu'à la fin de la simulation, pour que les
+ * autres threads explorent d'autres branches. `MctsRootParallel` construit un
+ * arbre indépendant par thread (le premier est `tree`, les autres sont
+ * temporaires) et additionne les visites des coups de la racine.
+ *
+ * @param tree Pointeur vers l'arbre conservé entre les tours.
+ * @param state Pointeur vers l'état de jeu, rendu inchangé.
+ * @param limits Les limites de la recherche.
+ * @return MctsResult Le coup choisi et les statistiques.
+ */
+MctsResult mcts_search(MctsTree *tree, GameState *state, MctsLimits limits);
+
+/**
+ * @brief Fait jouer le moteur Monte Carlo pour le joueur dont c'est le tour.
+ *
+ * Équivalent de `play_engine_turn` : annonce le coup puis le pose sans passer
+ * la main.
+ *
+ * @param state Pointeur vers l'état de jeu.
+ * @param tree Pointeur vers l'arbre conservé entre les tours.
+ * @param limits Les limites de la recherche.
+ * @return bool `false` si le moteur n'a aucun coup légal.
+ */
+bool play_mcts_turn(GameState *state, MctsTree *tree, MctsLimits limits);
+
+#endif // MCTS_H
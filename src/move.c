@@ -0,0 +1,62 @@
+#include "move.h"
+#include "capture.h"
+#include "zobrist.h"
+#include <assert.h>
+
+void make_move(GameState *state, const Move move, UndoRecord *undo) {
+  const Player player = state->is_turn_of;
+  const Player other = (player == User) ? Opponent : User;
+  const BitBoard owned_before = state->board.planes.captured_by[player];
+  const BitBoard other_before = state->board.planes.captured_by[other];
+
+  undo->move = move;
+  undo->square_owner = state->board.tiles[move.y][move.x].captured_by;
+  undo->counters[User] = state->piece_counter_1;
+  undo->counters[Opponent] = state->piece_counter_2;
+  for (int p = 0; p < 2; ++p) {
+    undo->owned_occupied[p] = state->owned_occupied[p];
+    undo->owned_empty[p] = state->owned_empty[p];
+    undo->kinds_present[p] = state->kinds_present[p];
+  }
+  undo->hash = state->hash;
+
+  place_piece(state, (PieceKind)move.kind, move.x, move.y);
+
+  // Les captures ne font que donner des cases au joueur qui pose la pièce
+  BitBoard gained = bb_andnot(state->board.planes.captured_by[player],
+                              owned_before);
+  bb_clear(&gained, move.x, move.y);
+  undo->taken_from[other] = bb_and(gained, other_before);
+  undo->taken_from[player] = bb_empty();
+  undo->taken_unowned = bb_andnot(gained, other_before);
+
+  toggle_user_turn(state);
+}
+
+void unmake_move(GameState *state, const UndoRecord *undo) {
+  const Move move = undo->move;
+  Board *board = &state->board;
+
+  // Les opérations se font au niveau du plateau : les compteurs et la clé de
+  // l'état sont restaurés en bloc ensuite.
+  capture_tiles(board, undo->taken_from[User], User);
+  capture_tiles(board, undo->taken_from[Opponent], Opponent);
+  release_tiles(board, undo->taken_unowned);
+
+  Tile empty = empty_tile();
+  empty.captured_by = undo->square_owner;
+  set_board_tile(board, move.x, move.y, empty);
+
+  state->is_turn_of = (state->is_turn_of == User) ? Opponent : User;
+  state->piece_counter_1 = undo->counters[User];
+  state->piece_counter_2 = undo->counters[Opponent];
+  for (int p = 0; p < 2; ++p) {
+    state->owned_occupied[p] = undo->owned_occupied[p];
+    state->owned_empty[p] = undo->owned_empty[p];
+    state->kinds_present[p] = undo->kinds_present[p];
+  }
+  state->hash = undo->hash;
+
+  assert(check_capture_counters(state));
+  assert(state->hash == compute_hash(state));
+}
@@ -0,0 +1,59 @@
+#ifndef MOVE_H
+#define MOVE_H
+#include "game_state.h"
+
+/**
+ * @brief Représente un coup : la pose d'une pièce sur une case.
+ *
+ * Le joueur qui pose la pièce est toujours celui dont c'est le tour.
+ */
+typedef struct {
+  uint8_t kind; ///< Type de la pièce posée (`PieceKind`)
+  uint8_t x;    ///< Colonne de la case
+  uint8_t y;    ///< Ligne de la case
+} Move;
+
+/**
+ * @brief Informations nécessaires pour annuler un coup.
+ *
+ * Taille fixe, sans allocation : seules les cases dont le propriétaire a
+ * changé sont enregistrées, sous forme de masques regroupés par ancien
+ * propriétaire. Les compteurs, les masques de présence et la clé sont
+ * sauvegardés tels quels (quelques octets).
+ */
+typedef struct {
+  Move move;                     ///< Coup joué
+  PlayerOption square_owner;     ///< Ancien propriétaire de la case jouée
+  BitBoard taken_from[2];        ///< Cases reprises à chaque joueur
+  BitBoard taken_unowned;        ///< Cases qui n'avaient pas de propriétaire
+  PieceCountTracker counters[2]; ///< Compteurs de pièces avant le coup
+  uint8_t owned_occupied[2];     ///< Compteurs de cases avant le coup
+  uint8_t owned_empty[2];
+  uint8_t kinds_present[2];
+  uint64_t hash; ///< Clé de Zobrist avant le coup
+} UndoRecord;
+
+/**
+ * @brief Joue un coup et passe la main à l'autre joueur.
+ *
+ * Pose la pièce avec `place_piece` (captures comprises), puis inverse le tour.
+ * Le coup doit être légal : aucune vérification n'est faite.
+ *
+ * @param state Pointeur vers l'état de jeu à modifier.
+ * @param move Le coup à jouer.
+ * @param undo Enregistrement rempli pour permettre `unmake_move`.
+ */
+void make_move(GameState *state, Move move, UndoRecord *undo);
+
+/**
+ * @brief Annule le dernier coup joué avec `make_move`.
+ *
+ * Les coups doivent être annulés dans l'ordre inverse de celui où ils ont été
+ * joués.
+ *
+ * @param state Pointeur vers l'état de jeu à restaurer.
+ * @param undo L'enregistrement rempli par `make_move`.
+ */
+void unmake_move(GameState *state, const UndoRecord *undo);
+
+#endif // MOVE_H
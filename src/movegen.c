@@ -0,0 +1,118 @@
+#include "movegen.h"
+#include "attack.h"
+
+// Cases atteintes par les pièces `kind` posées sur une case capturée par le
+// joueur actuel : union des `attackers_to_tile` vue depuis les pièces.
+static BitBoard reach_of_kind(const GameState *state, const PieceKind kind) {
+  const Board *board = &state->board;
+  const Player player = state->is_turn_of;
+  BitBoard pieces = bb_and(board->planes.by_kind[kind],
+                           board->planes.captured_by[player]);
+  BitBoard reach = bb_empty();
+  uint8_t x, y;
+
+  while (bb_pop_square(&pieces, &x, &y)) {
+    switch (kind) {
+    case King:
+      reach = bb_or(reach, king_attacks(board->dim, x, y));
+      break;
+    case Knight:
+      reach = bb_or(reach, knight_attacks(board->dim, x, y));
+      break;
+    case Pawn:
+      reach = bb_or(reach, pawn_attacks(player, board->dim, x, y));
+      break;
+    case Rook:
+      reach = bb_or(reach, rook_attacks(board->dim, board->planes.occupied, x, y));
+      break;
+    case Bishop:
+      reach = bb_or(reach, bishop_attacks(board->dim, board->planes.occupied, x, y));
+      break;
+    case Queen:
+      reach = bb_or(reach, queen_attacks(board->dim, board->planes.occupied, x, y));
+      break;
+    default:
+      break;
+    }
+  }
+
+  return reach;
+}
+
+BitBoard legal_squares_for(const GameState *state, const PieceKind kind) {
+  const BoardPlanes *planes = &state->board.planes;
+  const BitBoard empty = bb_andnot(planes->inside, planes->occupied);
+
+  if (state->mode == Conquest || kind == Pawn)
+    return empty;
+
+  // Hiérarchie du mode Connect : Pion -> Cavalier -> Fou -> Tour -> Reine -> Roi
+  PieceKind required;
+  switch (kind) {
+  case Knight:
+    required = Pawn;
+    break;
+  case Bishop:
+    required = Knight;
+    break;
+  case Rook:
+    required = Bishop;
+    break;
+  case Queen:
+    required = Rook;
+    break;
+  case King:
+    required = Queen;
+    break;
+  default:
+    return bb_empty();
+  }
+
+  if (!has_kind_on_captured_tile(state, state->is_turn_of, required))
+    return bb_empty();
+
+  const BitBoard owned = bb_and(empty, planes->captured_by[state->is_turn_of]);
+  return bb_and(owned, reach_of_kind(state, required));
+}
+
+size_t generate_moves(const GameState *state, Move *moves) {
+  const PieceCountTracker *counter = get_user_turn_count_tracker(state);
+  size_t count = 0;
+
+  for (int kind = King; kind <= Pawn; ++kind) {
+    if (get_piece_count(counter, (PieceKind)kind) == 0)
+      continue;
+
+    BitBoard squares = legal_squares_for(state, (PieceKind)kind);
+    uint8_t x, y;
+    while (bb_pop_square(&squares, &x, &y))
+      moves[count++] = (Move){.kind = (uint8_t)kind, .x = x, .y = y};
+  }
+
+  return count;
+}
+
+bool pick_random_move(const GameState *state, Rng *rng, Move *move) {
+  const PieceCountTracker *counter = get_user_turn_count_tracker(state);
+  BitBoard squares[6];
+  PieceKind kinds[6];
+  uint32_t kind_count = 0;
+
+  for (int kind = King; kind <= Pawn; ++kind) {
+    if (get_piece_count(counter, (PieceKind)kind) == 0)
+      continue;
+
+    squares[kind_count] = legal_squares_for(state, (PieceKind)kind);
+    if (!bb_is_empty(squares[kind_count]))
+      kinds[kind_count++] = (PieceKind)kind;
+  }
+
+  if (kind_count == 0)
+    return false;
+
+  const uint32_t chosen = rng_below(rng, kind_count);
+  const int index =
+      (int)rng_below(rng, (uint32_t)bb_popcount(squares[chosen]));
+  move->kind = (uint8_t)kinds[chosen];
+  return bb_nth_square(squares[chosen], index, &move->x, &move->y);
+}
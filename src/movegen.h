@@ -0,0 +1,51 @@
+#ifndef MOVEGEN_H
+#define MOVEGEN_H
+#include "move.h"
+#include "rng.h"
+#include <stddef.h>
+
+/// Nombre maximal de coups possibles : 6 types de pièces sur 144 cases.
+#define MAX_MOVES (6 * BITBOARD_MAX_DIM * BITBOARD_MAX_DIM)
+
+/**
+ * @brief Renvoie les cases où le joueur actuel peut poser une pièce d'un type.
+ *
+ * Applique les mêmes règles que la saisie interactive : en mode Conquest toute
+ * case vide ; en mode Connect la hiérarchie des pièces
+ * (`has_tile_captured_by_kind_for_current_player`) puis
+ * `is_valid_connect_placement`. Le compteur de pièces n'est pas consulté.
+ *
+ * @param state Pointeur vers l'état de jeu.
+ * @param kind Le type de pièce à poser.
+ * @return BitBoard Le masque des cases autorisées.
+ */
+BitBoard legal_squares_for(const GameState *state, PieceKind kind);
+
+/**
+ * @brief Énumère tous les coups légaux du joueur dont c'est le tour.
+ *
+ * Pour chaque type de pièce encore disponible dans son `PieceCountTracker`,
+ * écrit un coup par case autorisée par `legal_squares_for`. N'alloue aucune
+ * mémoire. Si aucun coup n'est renvoyé, la partie ne peut pas continuer.
+ *
+ * @param state Pointeur vers l'état de jeu.
+ * @param moves Tableau fourni par l'appelant, d'au moins `MAX_MOVES` cases.
+ * @return size_t Le nombre de coups écrits.
+ */
+size_t generate_moves(const GameState *state, Move *moves);
+
+/**
+ * @brief Tire au hasard un coup légal, sans énumérer tous les coups.
+ *
+ * Choisit d'abord un type de pièce parmi ceux qui sont disponibles et ont au
+ * moins une case autorisée, puis une case parmi celles-ci. Sert aux parties
+ * aléatoires (simulations Monte Carlo, ouvertures).
+ *
+ * @param state Pointeur vers l'état de jeu.
+ * @param rng Le générateur à utiliser.
+ * @param move Le coup tiré.
+ * @return bool `false` si le joueur n'a aucun coup légal.
+ */
+bool pick_random_move(const GameState *state, Rng *rng, Move *move);
+
+#endif // MOVEGEN_H
@@ -54,6 +54,26 @@ bool add_piece(PieceCountTracker *counter, const PieceKind piece) {
   return false;
 }
 
+uint8_t get_piece_count(const PieceCountTracker *counter,
+                        const PieceKind piece) {
+  switch (piece) {
+  case Pawn:
+    return counter->pawns;
+  case Knight:
+    return counter->knights;
+  case Bishop:
+    return counter->bishops;
+  case Rook:
+    return counter->rooks;
+  case Queen:
+    return counter->queen;
+  case King:
+    return counter->king;
+  default:
+    return 0;
+  }
+}
+
 void set_all_to_zero(PieceCountTracker *counter) {
   counter->pawns = 0;
   counter->knights = 0;
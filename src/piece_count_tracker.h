@@ -61,6 +61,18 @@ PieceCountTracker init_piece_counter();
  */
 bool add_piece(PieceCountTracker *counter, const PieceKind piece);
 
+/**
+ * @brief Renvoie le nombre de pièces d'un type encore disponibles.
+ *
+ * Contrairement à `add_piece`, cette fonction ne modifie pas le compteur : elle
+ * permet de vérifier qu'une pièce peut être posée avant de la consommer.
+ *
+ * @param counter Pointeur vers le compteur de pièces du joueur.
+ * @param piece Le type de pièce.
+ * @return uint8_t Le nombre de pièces de ce type encore disponibles.
+ */
+uint8_t get_piece_count(const PieceCountTracker *counter, PieceKind piece);
+
 /**
  * @brief Réinitialise tous les compteurs de pièces à zéro.
  *
@@ -0,0 +1,123 @@
+#include "pool.h"
+#include "thread.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+// Plage [début, fin) d'un thread : début dans les 32 bits de poids faible,
+// fin dans les 32 bits de poids fort, pour la modifier en une seule opération.
+// Une plage par ligne de cache, pour que les threads ne se gênent pas.
+typedef struct {
+  volatile uint64_t range;
+  uint8_t padding[64 - sizeof(uint64_t)];
+} WorkRange;
+
+typedef struct {
+  WorkRange *ranges;
+  uint32_t threads;
+  PoolTask task;
+  void *context;
+} Pool;
+
+typedef struct {
+  Pool *pool;
+  uint32_t id;
+  Thread thread;
+  bool running;
+} PoolWorker;
+
+static uint64_t pack_range(const uint32_t begin, const uint32_t end) {
+  return (uint64_t)end << 32 | begin;
+}
+
+// Prend le premier indice de la plage du thread
+static bool pop_own(WorkRange *own, uint32_t *index) {
+  uint64_t range = atomic_load_acquire_u64(&own->range);
+  for (;;) {
+    const uint32_t begin = (uint32_t)range;
+    const uint32_t end = (uint32_t)(range >> 32);
+    if (begin >= end)
+      return false;
+    if (atomic_cas_u64(&own->range, &range, pack_range(begin + 1, end))) {
+      *index = begin;
+      return true;
+    }
+  }
+}
+
+// Vole la moitié haute de la plage d'un autre thread. Le premier indice volé
+// est renvoyé, le reste devient la plage du voleur.
+static bool steal(Pool *pool, const uint32_t thief, uint32_t *index) {
+  for (uint32_t k = 1; k < pool->threads; ++k) {
+    WorkRange *victim = &pool->ranges[(thief + k) % pool->threads];
+    uint64_t range = atomic_load_acquire_u64(&victim->range);
+
+    for (;;) {
+      const uint32_t begin = (uint32_t)range;
+      const uint32_t end = (uint32_t)(range >> 32);
+      if (begin >= end)
+        break;
+
+      const uint32_t middle = begin + (end - begin) / 2;
+      if (atomic_cas_u64(&victim->range, &range, pack_range(begin, middle))) {
+        atomic_store_release_u64(&pool->ranges[thief].range,
+                                 pack_range(middle + 1, end));
+        *index = middle;
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+static void run_pool_worker(void *arg) {
+  PoolWorker *worker = arg;
+  Pool *pool = worker->pool;
+  WorkRange *own = &pool->ranges[worker->id];
+  uint32_t index;
+
+  while (pop_own(own, &index) || steal(pool, worker->id, &index))
+    pool->task(pool->context, worker->id, index);
+}
+
+void parallel_for(uint32_t threads, const uint32_t count, const PoolTask task,
+                  void *context) {
+  if (threads == 0)
+    threads = 1;
+  if (threads > count && count > 0)
+    threads = count;
+
+  Pool pool = {.threads = threads, .task = task, .context = context};
+  pool.ranges = calloc(threads, sizeof(WorkRange));
+  PoolWorker *workers = calloc(threads, sizeof(PoolWorker));
+  if (pool.ranges == NULL || workers == NULL) {
+    perror("Failed to allocate memory for the thread pool");
+    exit(EXIT_FAILURE);
+  }
+
+  for (uint32_t i = 0; i < threads; ++i) {
+    const uint32_t begin = (uint32_t)((uint64_t)count * i / threads);
+    const uint32_t end = (uint32_t)((uint64_t)count * (i + 1) / threads);
+    pool.ranges[i].range = pack_range(begin, end);
+    workers[i] = (PoolWorker){.pool = &pool, .id = i};
+  }
+
+  for (uint32_t i = 1; i < threads; ++i)
+    workers[i].running =
+        start_thread(&workers[i].thread, run_pool_worker, &workers[i]);
+  run_pool_worker(&workers[0]);
+
+  for (uint32_t i = 1; i < threads; ++i) {
+    if (workers[i].running)
+      join_thread(workers[i].thread);
+  }
+
+  // Plages d'un thread qui n'a pas pu démarrer : terminées ici
+  uint32_t index;
+  for (uint32_t i = 1; i < threads; ++i) {
+    while (!workers[i].running && pop_own(&pool.ranges[i], &index))
+      task(context, 0, index);
+  }
+
+  free(workers);
+  free(pool.ranges);
+}
@@ -0,0 +1,33 @@
+#ifndef POOL_H
+#define POOL_H
+#include <stdint.h>
+
+/**
+ * @brief Tâche exécutée pour chaque indice d'un `parallel_for`.
+ *
+ * @param context Le contexte passé à `parallel_for`.
+ * @param worker Numéro du thread qui exécute la tâche (de 0 à `threads - 1`),
+ * pour accéder à des ressources propres au thread.
+ * @param index L'indice à traiter.
+ */
+typedef void (*PoolTask)(void *context, uint32_t worker, uint32_t index);
+
+/**
+ * @brief Exécute `task` pour chaque indice de [0, count) sur plusieurs threads.
+ *
+ * Les indices sont d'abord répartis en plages égales, une par thread. Un
+ * thread qui a vidé sa plage vole la moitié haute de la plage d'un autre :
+ * les tâches de durées très différentes (parties sur 6x6 et sur 12x12)
+ * restent bien réparties. Les plages sont modifiées par compare-and-swap,
+ * sans verrou. Le thread appelant est le thread 0 ; la fonction rend la main
+ * quand tous les indices ont été traités.
+ *
+ * @param threads Nombre de threads (0 ou 1 : thread appelant uniquement).
+ * @param count Nombre d'indices.
+ * @param task La tâche à exécuter.
+ * @param context Pointeur transmis à chaque appel de `task`.
+ */
+void parallel_for(uint32_t threads, uint32_t count, PoolTask task,
+                  void *context);
+
+#endif // POOL_H
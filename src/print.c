@@ -1,11 +1,49 @@
 #include "print.h"
+#include <errno.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <io.h>
+#define isatty _isatty
+#define fileno _fileno
+#endif
+
+void print_buffer(const char *data, size_t length) {
+  fflush(stdout);
+#ifdef _WIN32
+  fwrite(data, 1, length, stdout);
+  fflush(stdout);
+#else
+  while (length > 0) {
+    const ssize_t written = write(STDOUT_FILENO, data, length);
+    if (written < 0) {
+      if (errno == EINTR)
+        continue;
+      return;
+    }
+    data += written;
+    length -= (size_t)written;
+  }
+#endif
+}
 
 void print_effect(const char *str, const unsigned int delay_ms) {
-  for (const char *c = str; *c != '\0'; ++c) {
-    putchar(*c);
-    fflush(stdout); // fais apparaitre directement le char
+  if (!isatty(fileno(stdout))) {
+    print_buffer(str, strlen(str));
+    return;
+  }
+
+  const char *c = str;
+  while (*c != '\0') {
+    // octets de continuation UTF-8 : 10xxxxxx
+    size_t length = 1;
+    while ((c[length] & 0xC0) == 0x80)
+      length++;
+
+    print_buffer(c, length); // fais apparaitre directement le caractère
+    c += length;
     sleep_ms(delay_ms);
   }
 }
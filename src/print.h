@@ -2,6 +2,8 @@
 #ifndef PRINT_H
 #define PRINT_H
 
+#include <stddef.h>
+
 #ifdef _WIN32
 #include <windows.h>
 #define sleep_ms(x) Sleep(x)
@@ -10,9 +12,24 @@
 #define sleep_ms(x) usleep(x * 1000)
 #endif
 
+/**
+ * @brief Écrit un tampon sur la sortie standard en un seul bloc.
+ *
+ * Vide d'abord ce qui attend dans le tampon de `stdout`, puis écrit les
+ * données directement : une image complète part en une seule écriture au
+ * lieu de centaines de petits paquets.
+ *
+ * @param data Les octets à écrire.
+ * @param length Leur nombre.
+ */
+void print_buffer(const char *data, size_t length);
+
 /**
  * @brief Affiche une chaîne de caractères avec un effet machine à écrire,
  * ajoutant un délai entre chaque caractère.
+ *
+ * Un caractère UTF-8 sur plusieurs octets est écrit d'un bloc. Si la sortie
+ * n'est pas un terminal (redirection, tube), la chaîne est écrite d'un coup.
  * @param str La chaîne à afficher.
  * @param delay_ms Le délai en millisecondes entre chaque caractère.
  */
@@ -0,0 +1,429 @@
+#include "protocol.h"
+#include "movegen.h"
+#include "save.h"
+#include "search.h"
+#include <ctype.h>
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// Une ligne `position` d'un plateau 12x12 tient largement dans ce tampon
+#define PROTOCOL_LINE_MAX 8192
+#define PROTOCOL_MCTS_CAPACITY (1u << 20)
+// Temps de réflexion d'un `go` sans limite avec l'alpha-bêta : une
+// profondeur fixe peut prendre des minutes sur les grands plateaux
+#define PROTOCOL_DEFAULT_TIME_MS 1000
+
+typedef enum { ProtocolAlphaBeta, ProtocolMcts } ProtocolEngine;
+
+// État d'une session : partie en cours et ressources des moteurs
+typedef struct {
+  FILE *out;
+  GameState state;
+  bool has_game;
+  ProtocolEngine engine;
+  ProtocolOptions options;
+  size_t hash_mb;
+  TranspositionTable tt;
+  MctsTree tree;
+} Session;
+
+// Découpe le prochain mot de `*cursor` (le termine par '\0')
+static char *next_token(char **cursor) {
+  char *c = *cursor;
+  while (*c && isspace((unsigned char)*c))
+    c++;
+  if (*c == '\0') {
+    *cursor = c;
+    return NULL;
+  }
+
+  char *token = c;
+  while (*c && !isspace((unsigned char)*c))
+    c++;
+  if (*c)
+    *c++ = '\0';
+  *cursor = c;
+  return token;
+}
+
+static bool equals_ignore_case(const char *a, const char *b) {
+  while (*a && *b) {
+    if (tolower((unsigned char)*a) != tolower((unsigned char)*b))
+      return false;
+    a++;
+    b++;
+  }
+  return *a == *b;
+}
+
+// Accepte le nom complet (Queen) ou l'initiale anglaise (Q, N pour Knight)
+static bool parse_piece(const char *str, PieceKind *kind) {
+  static const char letters[] = "KQRBNP";
+
+  for (int k = King; k <= Pawn; ++k) {
+    if (equals_ignore_case(str, stringify_piece((PieceKind)k)) ||
+        (str[1] == '\0' && toupper((unsigned char)str[0]) == letters[k])) {
+      *kind = (PieceKind)k;
+      return true;
+    }
+  }
+  return false;
+}
+
+static void reply_error(Session *session, const char *message) {
+  fprintf(session->out, "error %s\n", message);
+}
+
+// Entier décimal de 1 à `max`, sans signe ni caractère en trop
+static bool parse_number(const char *value, const uint32_t max,
+                         uint32_t *number) {
+  if (!isdigit((unsigned char)value[0]))
+    return false;
+
+  errno = 0;
+  char *end;
+  const unsigned long parsed = strtoul(value, &end, 10);
+  if (*end != '\0' || errno == ERANGE || parsed == 0 || parsed > max)
+    return false;
+  *number = (uint32_t)parsed;
+  return true;
+}
+
+static void write_move(Session *session, const Move move) {
+  char position[4];
+  format_position(session->state.board.dim, move.x, move.y, position);
+  fprintf(session->out, "%s %s", stringify_piece((PieceKind)move.kind),
+          position);
+}
+
+static void set_game(Session *session, const GameState state) {
+  if (session->has_game)
+    free_game_state(&session->state);
+  session->state = state;
+  session->has_game = true;
+  // L'ancien arbre ne correspond plus à la partie
+  session->tree.root = MCTS_NO_NODE;
+}
+
+static void command_newgame(Session *session, char *args) {
+  const char *mode_str = next_token(&args);
+  const char *dim_str = next_token(&args);
+  if (!mode_str || !dim_str) {
+    reply_error(session, "usage: newgame <conquest|connect> <dim>");
+    return;
+  }
+
+  GameMode mode;
+  if (equals_ignore_case(mode_str, "conquest"))
+    mode = Conquest;
+  else if (equals_ignore_case(mode_str, "connect"))
+    mode = Connect;
+  else {
+    reply_error(session, "unknown mode");
+    return;
+  }
+
+  uint32_t dim;
+  if (!parse_number(dim_str, 12, &dim) || dim < 6) {
+    reply_error(session, "dimension must be between 6 and 12");
+    return;
+  }
+
+  // Partie reproductible : User joue les blancs et commence
+  const GameState state = init_game_state_with(mode, (uint8_t)dim, User);
+
+  set_game(session, state);
+  fprintf(session->out, "ok\n");
+}
+
+static void command_position(Session *session, char *args) {
+  // Les champs d'en-tête sont séparés par des espaces au lieu de retours à
+  // la ligne : on rétablit le format de savegame.dat avant `tiles=`
+  char *tiles = strstr(args, "tiles=");
+  if (!tiles) {
+    reply_error(session, "missing tiles=");
+    return;
+  }
+  for (char *c = args; c < tiles; ++c) {
+    if (*c == ' ' || *c == '\t')
+      *c = '\n';
+  }
+
+  GameState state;
+  const DeserializeResult result = deserialize_safe(args, &state);
+  if (result != DESERIALIZE_SUCCESS) {
+    reply_error(session, deserialize_error_message(result));
+    return;
+  }
+
+  set_game(session, state);
+  fprintf(session->out, "ok\n");
+}
+
+static void report_game_over(Session *session) {
+  const GameState *state = &session->state;
+  const int score = compare_scores(state, User);
+  const char *winner = score > 0 ? "User" : score < 0 ? "Opponent" : "Draw";
+
+  fprintf(session->out, "gameover %s occupied %d %d empty %d %d\n", winner,
+          state->owned_occupied[User], state->owned_occupied[Opponent],
+          state->owned_empty[User], state->owned_empty[Opponent]);
+}
+
+static void command_place(Session *session, char *args) {
+  const char *piece_str = next_token(&args);
+  const char *square_str = next_token(&args);
+  if (!piece_str || !square_str) {
+    reply_error(session, "usage: place <piece> <square>");
+    return;
+  }
+
+  GameState *state = &session->state;
+  PieceKind kind;
+  Move move;
+  if (!parse_piece(piece_str, &kind)) {
+    reply_error(session, "unknown piece");
+    return;
+  }
+  if (!parse_position(state->board.dim, square_str, &move.x, &move.y)) {
+    reply_error(session, "invalid square");
+    return;
+  }
+  if (is_game_over(state)) {
+    reply_error(session, "game is over");
+    return;
+  }
+  if (get_piece_count(get_user_turn_count_tracker(state), kind) == 0) {
+    reply_error(session, "no piece of this kind left");
+    return;
+  }
+
+  const BitBoard legal = legal_squares_for(state, kind);
+  if (!bb_test(&legal, move.x, move.y)) {
+    reply_error(session, "illegal square");
+    return;
+  }
+
+  move.kind = (uint8_t)kind;
+  UndoRecord undo;
+  make_move(state, move, &undo);
+  fprintf(session->out, "ok\n");
+
+  Move replies[MAX_MOVES];
+  if (is_game_over(state) || generate_moves(state, replies) == 0)
+    report_game_over(session);
+}
+
+static void command_go(Session *session, char *args) {
+  uint32_t time_ms = 0;
+  uint32_t depth = 0;
+  uint32_t playouts = 0;
+
+  const char *name;
+  while ((name = next_token(&args)) != NULL) {
+    const char *value = next_token(&args);
+    if (!value) {
+      reply_error(session, "missing value");
+      return;
+    }
+    if (strcmp(name, "time") == 0) {
+      if (!parse_number(value, UINT32_MAX, &time_ms)) {
+        reply_error(session, "invalid time");
+        return;
+      }
+    } else if (strcmp(name, "depth") == 0) {
+      if (!parse_number(value, SEARCH_MAX_PLY - 1, &depth)) {
+        reply_error(session, "invalid depth");
+        return;
+      }
+    } else if (strcmp(name, "playouts") == 0) {
+      if (!parse_number(value, UINT32_MAX, &playouts)) {
+        reply_error(session, "invalid playouts");
+        return;
+      }
+    } else {
+      reply_error(session, "unknown go parameter");
+      return;
+    }
+  }
+
+  // Chaque moteur n'a que sa propre limite, en plus du temps
+  if (session->engine == ProtocolMcts && depth != 0) {
+    reply_error(session, "depth needs engine alphabeta");
+    return;
+  }
+  if (session->engine == ProtocolAlphaBeta && playouts != 0) {
+    reply_error(session, "playouts needs engine mcts");
+    return;
+  }
+
+  GameState *state = &session->state;
+  bool found;
+  Move best;
+
+  if (session->engine == ProtocolMcts) {
+    if (session->tree.nodes == NULL)
+      session->tree = init_mcts_tree(PROTOCOL_MCTS_CAPACITY, (uint64_t)time(0));
+
+    const MctsLimits limits = {.playouts = playouts,
+                               .time_limit_ms = time_ms,
+                               .threads = session->options.threads,
+                               .parallelism = session->options.parallelism};
+    const MctsResult result = mcts_search(&session->tree, state, limits);
+    found = result.found;
+    best = result.best_move;
+    fprintf(session->out, "info playouts %u winrate %.3f time %llu\n",
+            result.playouts, result.win_rate,
+            (unsigned long long)result.time_ms);
+  } else {
+    if (session->tt.entries == NULL)
+      session->tt = init_tt(session->hash_mb);
+
+    // Sans aucune limite, la recherche s'arrête au bout d'un temps fixe
+    if (depth == 0 && time_ms == 0)
+      time_ms = PROTOCOL_DEFAULT_TIME_MS;
+    const SearchLimits limits = {
+        .max_depth = (uint8_t)depth,
+        .time_limit_ms = time_ms,
+        .threads = session->options.threads,
+        .tt = &session->tt};
+    const SearchResult result = search_best_move(state, limits);
+    found = result.found;
+    best = result.best_move;
+    fprintf(session->out, "info depth %u score %d nodes %llu time %llu\n",
+            result.depth, result.score, (unsigned long long)result.nodes,
+            (unsigned long long)result.time_ms);
+  }
+
+  if (!found) {
+    fprintf(session->out, "bestmove none\n");
+    return;
+  }
+  fprintf(session->out, "bestmove ");
+  write_move(session, best);
+  fprintf(session->out, "\n");
+}
+
+static void command_moves(Session *session) {
+  Move moves[MAX_MOVES];
+  const size_t count =
+      is_game_over(&session->state) ? 0 : generate_moves(&session->state, moves);
+
+  fprintf(session->out, "moves %zu", count);
+  for (size_t i = 0; i < count; ++i) {
+    fprintf(session->out, " ");
+    write_move(session, moves[i]);
+  }
+  fprintf(session->out, "\n");
+}
+
+static void command_show(Session *session) {
+  char str[SERIALIZE_MAX_SIZE + 1];
+  const size_t length = serialize_to_buffer(&session->state, str, sizeof(str));
+
+  // Une seule ligne : les retours à la ligne intérieurs deviennent des espaces
+  for (size_t i = 0; i + 1 < length; ++i) {
+    if (str[i] == '\n')
+      str[i] = ' ';
+  }
+
+  fprintf(session->out, "position %s", str);
+}
+
+static void command_setoption(Session *session, char *args) {
+  const char *name = next_token(&args);
+  const char *value = next_token(&args);
+  if (!name || !value) {
+    reply_error(session, "usage: setoption <name> <value>");
+    return;
+  }
+
+  if (strcmp(name, "threads") == 0) {
+    uint32_t threads;
+    if (!parse_number(value, UINT32_MAX, &threads)) {
+      reply_error(session, "threads must be a whole number, at least 1");
+      return;
+    }
+    session->options.threads = threads;
+  } else if (strcmp(name, "engine") == 0) {
+    if (strcmp(value, "alphabeta") == 0)
+      session->engine = ProtocolAlphaBeta;
+    else if (strcmp(value, "mcts") == 0)
+      session->engine = ProtocolMcts;
+    else {
+      reply_error(session, "engine must be alphabeta or mcts");
+      return;
+    }
+  } else if (strcmp(name, "hash") == 0) {
+    uint32_t megabytes;
+    if (!parse_number(value, UINT32_MAX, &megabytes)) {
+      reply_error(session, "hash must be a whole number, at least 1");
+      return;
+    }
+    session->hash_mb = (size_t)megabytes;
+    // La table sera réallouée à la prochaine recherche
+    if (session->tt.entries != NULL)
+      free_tt(&session->tt);
+  } else {
+    reply_error(session, "unknown option");
+    return;
+  }
+  fprintf(session->out, "ok\n");
+}
+
+int run_engine_protocol(FILE *in, FILE *out, const ProtocolOptions options) {
+  Session session = {.out = out,
+                     .engine = ProtocolAlphaBeta,
+                     .options = options,
+                     .hash_mb = TT_DEFAULT_SIZE_MB,
+                     .tree = {.root = MCTS_NO_NODE}};
+  char *line = malloc(PROTOCOL_LINE_MAX);
+  if (line == NULL) {
+    perror("Failed to allocate memory for the protocol");
+    return 1;
+  }
+
+  while (fgets(line, PROTOCOL_LINE_MAX, in) != NULL) {
+    char *cursor = line;
+    const char *command = next_token(&cursor);
+    if (command == NULL)
+      continue;
+
+    if (strcmp(command, "quit") == 0)
+      break;
+
+    if (strcmp(command, "isready") == 0) {
+      fprintf(out, "readyok\n");
+    } else if (strcmp(command, "newgame") == 0) {
+      command_newgame(&session, cursor);
+    } else if (strcmp(command, "position") == 0) {
+      command_position(&session, cursor);
+    } else if (strcmp(command, "setoption") == 0) {
+      command_setoption(&session, cursor);
+    } else if (!session.has_game) {
+      reply_error(&session, "no game: use newgame or position first");
+    } else if (strcmp(command, "place") == 0) {
+      command_place(&session, cursor);
+    } else if (strcmp(command, "go") == 0) {
+      command_go(&session, cursor);
+    } else if (strcmp(command, "moves") == 0) {
+      command_moves(&session);
+    } else if (strcmp(command, "show") == 0) {
+      command_show(&session);
+    } else {
+      reply_error(&session, "unknown command");
+    }
+    fflush(out);
+  }
+
+  free(line);
+  if (session.has_game)
+    free_game_state(&session.state);
+  if (session.tt.entries != NULL)
+    free_tt(&session.tt);
+  if (session.tree.nodes != NULL)
+    free_mcts_tree(&session.tree);
+  return 0;
+}
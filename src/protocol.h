@@ -0,0 +1,46 @@
+#ifndef PROTOCOL_H
+#define PROTOCOL_H
+#include "mcts.h"
+#include <stdio.h>
+
+/**
+ * @brief Réglages initiaux du mode protocole.
+ */
+typedef struct {
+  uint32_t threads;            ///< Threads des moteurs
+  MctsParallelism parallelism; ///< Répartition de la recherche Monte Carlo
+} ProtocolOptions;
+
+/**
+ * @brief Pilote le jeu par un protocole texte, une commande par ligne.
+ *
+ * Aucun menu, aucun effacement d'écran ni aucune pause : chaque commande reçoit
+ * immédiatement une réponse d'une ligne (`ok`, `error <message>` ou le
+ * résultat demandé). Commandes reconnues :
+ *
+ * - `newgame <conquest|connect> <dim>` : nouvelle partie, User commence
+ * - `position <save-string>` : position au format de `savegame.dat`, les
+ *   lignes d'en-tête séparées par des espaces
+ *   (`mode=Conquest white=User turn=User dim=8 tiles= _:_:_ ...`)
+ * - `place <piece> <case>` : pose une pièce (ex: `place Queen C4`) pour le
+ *   joueur dont c'est le tour ; suivi de `gameover ...` si la partie se termine
+ * - `go [time <ms>] [depth <n>] [playouts <n>]` : cherche un coup sans le
+ *   jouer et répond `info ...` puis `bestmove <piece> <case>` ; `depth` est
+ *   réservé à l'alpha-bêta (1 à 63) et `playouts` à MCTS. Sans limite,
+ *   l'alpha-bêta cherche une seconde et MCTS fait `MCTS_DEFAULT_PLAYOUTS`
+ *   simulations
+ * - `moves` : liste des coups légaux
+ * - `show` : position actuelle, au format accepté par `position`
+ * - `setoption <threads|engine|hash> <valeur>` : `engine` vaut `alphabeta`
+ *   ou `mcts`, `hash` est la taille de la table en Mo ; `threads` et `hash`
+ *   sont des entiers d'au moins 1
+ * - `isready` (réponse `readyok`) et `quit`
+ *
+ * @param in Flux des commandes.
+ * @param out Flux des réponses.
+ * @param options Réglages initiaux.
+ * @return int Code de sortie du programme.
+ */
+int run_engine_protocol(FILE *in, FILE *out, ProtocolOptions options);
+
+#endif // PROTOCOL_H
@@ -0,0 +1,331 @@
+#include "render.h"
+#include "print.h"
+#include <assert.h>
+#include <stdbool.h>
+#include <string.h>
+
+#ifndef _WIN32
+#include <sys/ioctl.h>
+#endif
+
+// Une ligne de case : une espace puis cinq caractères, au plus 3 octets chacun
+#define RENDER_CELL_BYTES 16
+// Aspects d'une case : vide, capturée par User ou Opponent, puis les pièces
+#define RENDER_EMPTY 0
+#define RENDER_CAPTURED 1 // + Player
+#define RENDER_PIECES 3   // + Player * 6 + PieceKind
+#define RENDER_LOOKS (RENDER_PIECES + 2 * 6)
+#define RENDER_DIMS (BITBOARD_MAX_DIM + 1)
+// Ligne des lettres : marge, six octets par colonne et fin de ligne
+#define RENDER_LETTERS_BYTES (6 + 6 * BITBOARD_MAX_DIM + 16)
+// Lignes à garder sous le plateau pour les questions d'un tour
+#define RENDER_PROMPT_LINES 8
+
+// Position à l'écran (à partir de 1) de l'image écrite par `draw_board` : une
+// ligne de centrage, les lettres et une ligne vide, puis quatre lignes par
+// rangée de cases (trois de dessin et une vide), les lettres et une ligne vide
+#define SCREEN_BOARD_ROW 4 // Première ligne de dessin
+#define SCREEN_BOARD_COLUMN 6 // Espace qui précède la première case
+#define screen_tile_row(i, line) (SCREEN_BOARD_ROW + 4 * (i) + (line))
+#define screen_tile_column(j) (SCREEN_BOARD_COLUMN + 6 * (j))
+#define screen_digit_column(dim) (15 + 6 * (dim))
+#define screen_prompt_row(dim) (6 + 4 * (dim))
+#define screen_width(dim) (20 + 6 * (dim))
+
+typedef struct {
+  char text[3][RENDER_CELL_BYTES];
+  uint8_t length[3];
+} CellArt;
+
+static CellArt cell_art[RENDER_LOOKS];
+static bool cell_art_ready = false;
+
+// Ligne des lettres (sans fin de ligne), par dimension
+static char letters[RENDER_DIMS][RENDER_LETTERS_BYTES];
+static size_t letters_length[RENDER_DIMS];
+
+// Chiffres ASCII "1" et "2", affichés à droite des premières lignes
+static const char *const digits[2][5] = {
+    {"1111", "  11", "  11", "  11", "111111"},
+    {" 2222", "22  22", "   22", "  22", "222222"}};
+
+static void set_cell_art(CellArt *art, const AsciiPiece piece) {
+  const char *lines[3] = {piece.line1, piece.line2, piece.line3};
+
+  for (int line = 0; line < 3; ++line) {
+    const size_t length = strlen(lines[line]);
+    assert(length + 1 <= RENDER_CELL_BYTES);
+    art->text[line][0] = ' ';
+    memcpy(art->text[line] + 1, lines[line], length);
+    art->length[line] = (uint8_t)(length + 1);
+  }
+}
+
+static void init_cell_art(void) {
+  set_cell_art(&cell_art[RENDER_EMPTY],
+               (AsciiPiece){"·····", "·····", "·····"});
+  set_cell_art(&cell_art[RENDER_CAPTURED + User],
+               (AsciiPiece){"█████", "█████", "█████"});
+  set_cell_art(&cell_art[RENDER_CAPTURED + Opponent],
+               (AsciiPiece){"░░░░░", "░░░░░", "░░░░░"});
+
+  for (PieceKind kind = King; kind <= Pawn; ++kind) {
+    set_cell_art(&cell_art[RENDER_PIECES + User * 6 + kind],
+                 piece_as_white_ascii(kind));
+    set_cell_art(&cell_art[RENDER_PIECES + Opponent * 6 + kind],
+                 piece_as_black_ascii(kind));
+  }
+
+  for (uint8_t dim = 0; dim < RENDER_DIMS; ++dim) {
+    char *cursor = letters[dim];
+    memcpy(cursor, "      ", 6);
+    cursor += 6;
+    for (uint8_t j = 0; j < dim; ++j) {
+      memcpy(cursor, "  A   ", 6);
+      cursor[2] = (char)('A' + j);
+      cursor += 6;
+    }
+    letters_length[dim] = (size_t)(cursor - letters[dim]);
+  }
+
+  cell_art_ready = true;
+}
+
+static uint8_t look_of(const Tile tile) {
+  if (tile.some)
+    return (uint8_t)(RENDER_PIECES + tile.value.player * 6 + tile.value.kind);
+  if (tile.captured_by.some)
+    return (uint8_t)(RENDER_CAPTURED + tile.captured_by.player);
+  return RENDER_EMPTY;
+}
+
+static char *append(char *cursor, const char *text, const size_t length) {
+  memcpy(cursor, text, length);
+  return cursor + length;
+}
+
+static char *append_string(char *cursor, const char *text) {
+  return append(cursor, text, strlen(text));
+}
+
+// Numéro de ligne sur deux caractères, aligné à droite (comme "%2d")
+static char *append_row_number(char *cursor, const int number) {
+  *cursor++ = number >= 10 ? (char)('0' + number / 10) : ' ';
+  *cursor++ = (char)('0' + number % 10);
+  return cursor;
+}
+
+size_t render_board(const GameState *state, char *out) {
+  if (!cell_art_ready)
+    init_cell_art();
+
+  const uint8_t dim = state->board.dim;
+  const int player_index = (state->is_turn_of == User) ? 0 : 1;
+  char *cursor = out;
+
+  *cursor++ = '\n';
+  cursor = append(cursor, letters[dim], letters_length[dim]);
+  cursor = append_string(cursor, "    <-- Joueur\n\n");
+
+  for (uint8_t i = 0; i < dim; i++) {
+    const Tile *row = state->board.tiles[i];
+    const int number = dim - i;
+
+    for (int line = 0; line < 3; line++) {
+      if (line == 1) {
+        *cursor++ = ' ';
+        cursor = append_row_number(cursor, number);
+        cursor = append(cursor, "  ", 2);
+      } else {
+        cursor = append(cursor, "     ", 5);
+      }
+
+      for (uint8_t j = 0; j < dim; j++) {
+        const CellArt *art = &cell_art[look_of(row[j])];
+        cursor = append(cursor, art->text[line], art->length[line]);
+      }
+
+      if (line == 1) {
+        cursor = append(cursor, "   ", 3);
+        cursor = append_row_number(cursor, number);
+      }
+
+      // Le chiffre du joueur occupe les cinq premières lignes du plateau
+      const int ascii_line = i * 3 + line;
+      if (ascii_line < 5) {
+        if (line != 1)
+          cursor = append(cursor, "     ", 5);
+        cursor = append(cursor, "    ", 4);
+        cursor = append_string(cursor, digits[player_index][ascii_line]);
+      }
+
+      *cursor++ = '\n';
+    }
+    *cursor++ = '\n';
+  }
+
+  cursor = append(cursor, letters[dim], letters_length[dim]);
+  cursor = append(cursor, "\n\n", 2);
+
+  assert((size_t)(cursor - out) <= RENDER_FRAME_SIZE);
+  return (size_t)(cursor - out);
+}
+
+// Écrit un entier positif en décimal
+static char *append_number(char *cursor, unsigned number) {
+  char digits_buffer[10];
+  int count = 0;
+  do {
+    digits_buffer[count++] = (char)('0' + number % 10);
+    number /= 10;
+  } while (number > 0);
+  while (count > 0)
+    *cursor++ = digits_buffer[--count];
+  return cursor;
+}
+
+// Séquence CSI <a>;<b><final>
+static char *append_csi(char *cursor, const unsigned a, const unsigned b,
+                        const char final) {
+  cursor = append(cursor, "\x1b[", 2);
+  cursor = append_number(cursor, a);
+  *cursor++ = ';';
+  cursor = append_number(cursor, b);
+  *cursor++ = final;
+  return cursor;
+}
+
+static bool terminal_size(uint16_t *rows, uint16_t *columns) {
+#ifdef _WIN32
+  CONSOLE_SCREEN_BUFFER_INFO info;
+  if (!GetConsoleScreenBufferInfo(GetStdHandle(STD_OUTPUT_HANDLE), &info))
+    return false;
+  *rows = (uint16_t)(info.srWindow.Bottom - info.srWindow.Top + 1);
+  *columns = (uint16_t)(info.srWindow.Right - info.srWindow.Left + 1);
+#else
+  struct winsize size;
+  if (ioctl(STDOUT_FILENO, TIOCGWINSZ, &size) != 0 || size.ws_row == 0)
+    return false;
+  *rows = size.ws_row;
+  *columns = size.ws_col;
+#endif
+  return true;
+}
+
+void init_screen_renderer(ScreenRenderer *renderer) {
+  renderer->valid = false;
+#ifdef _WIN32
+#ifndef ENABLE_VIRTUAL_TERMINAL_PROCESSING
+#define ENABLE_VIRTUAL_TERMINAL_PROCESSING 0x0004
+#endif
+  const HANDLE output = GetStdHandle(STD_OUTPUT_HANDLE);
+  DWORD mode;
+  renderer->ansi =
+      GetConsoleMode(output, &mode) &&
+      SetConsoleMode(output, mode | ENABLE_VIRTUAL_TERMINAL_PROCESSING);
+#else
+  renderer->ansi = isatty(STDOUT_FILENO);
+#endif
+}
+
+void invalidate_screen(ScreenRenderer *renderer) { renderer->valid = false; }
+
+void release_screen(ScreenRenderer *renderer) {
+  if (renderer->ansi && renderer->valid) {
+    // Fin de la zone de défilement, curseur sous le plateau
+    char sequence[32];
+    char *cursor = append_string(sequence, "\x1b[r");
+    cursor = append_csi(cursor, screen_prompt_row(renderer->dim), 1, 'H');
+    print_buffer(sequence, (size_t)(cursor - sequence));
+  }
+  renderer->valid = false;
+}
+
+// Image complète, précédée de la ligne de centrage du titre
+static char *append_full_frame(char *cursor, const GameState *state) {
+  for (int i = 0; i < state->board.dim / 2 + 1; i++)
+    cursor = append(cursor, "   ", 3);
+  return cursor + render_board(state, cursor);
+}
+
+static void remember_looks(ScreenRenderer *renderer, const GameState *state) {
+  for (uint8_t i = 0; i < state->board.dim; ++i) {
+    for (uint8_t j = 0; j < state->board.dim; ++j)
+      renderer->looks[i][j] = look_of(state->board.tiles[i][j]);
+  }
+}
+
+void draw_board(ScreenRenderer *renderer, const GameState *state) {
+  if (!cell_art_ready)
+    init_cell_art();
+
+  const uint8_t dim = state->board.dim;
+  char *cursor = renderer->frame;
+
+  if (!renderer->ansi) {
+    // Sortie redirigée : l'image est simplement ajoutée à la suite
+    cursor = append_full_frame(cursor, state);
+    print_buffer(renderer->frame, (size_t)(cursor - renderer->frame));
+    return;
+  }
+
+  uint16_t rows = 0, columns = 0;
+  const bool fits = terminal_size(&rows, &columns) &&
+                    rows >= screen_prompt_row(dim) + RENDER_PROMPT_LINES &&
+                    columns >= screen_width(dim);
+
+  if (!renderer->valid || !fits || renderer->dim != dim ||
+      renderer->rows != rows || renderer->columns != columns) {
+    // Retour au défilement normal, effacement, image complète
+    cursor = append_string(cursor, "\x1b[r\x1b[H\x1b[2J\x1b[3J");
+    cursor = append_full_frame(cursor, state);
+
+    renderer->valid = fits;
+    if (fits) {
+      // Le plateau reste fixe, seules les lignes du dessous défilent
+      cursor = append_csi(cursor, screen_prompt_row(dim), rows, 'r');
+      cursor = append_csi(cursor, screen_prompt_row(dim), 1, 'H');
+      renderer->dim = dim;
+      renderer->turn = state->is_turn_of;
+      renderer->rows = rows;
+      renderer->columns = columns;
+      remember_looks(renderer, state);
+    }
+    print_buffer(renderer->frame, (size_t)(cursor - renderer->frame));
+    return;
+  }
+
+  for (uint8_t i = 0; i < dim; ++i) {
+    for (uint8_t j = 0; j < dim; ++j) {
+      const uint8_t look = look_of(state->board.tiles[i][j]);
+      if (look == renderer->looks[i][j])
+        continue;
+
+      const CellArt *art = &cell_art[look];
+      for (int line = 0; line < 3; ++line) {
+        cursor = append_csi(cursor, screen_tile_row(i, line),
+                            screen_tile_column(j), 'H');
+        cursor = append(cursor, art->text[line], art->length[line]);
+      }
+      renderer->looks[i][j] = look;
+    }
+  }
+
+  if (state->is_turn_of != renderer->turn) {
+    const int player_index = (state->is_turn_of == User) ? 0 : 1;
+    for (int line = 0; line < 5; ++line) {
+      cursor = append_csi(cursor, screen_tile_row(line / 3, line % 3),
+                          screen_digit_column(dim), 'H');
+      cursor = append_string(cursor, digits[player_index][line]);
+      cursor = append_string(cursor, "\x1b[K");
+    }
+    renderer->turn = state->is_turn_of;
+  }
+
+  // Efface les questions du tour précédent
+  cursor = append_csi(cursor, screen_prompt_row(dim), 1, 'H');
+  cursor = append_string(cursor, "\x1b[J");
+
+  assert((size_t)(cursor - renderer->frame) <= RENDER_FRAME_SIZE);
+  print_buffer(renderer->frame, (size_t)(cursor - renderer->frame));
+}
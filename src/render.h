@@ -0,0 +1,96 @@
+#ifndef RENDER_H
+#define RENDER_H
+#include "game_state.h"
+#include <stdbool.h>
+#include <stddef.h>
+
+/// Taille maximale d'une image du plateau (12x12, cases en UTF-8 comprises)
+#define RENDER_FRAME_SIZE 16384
+
+/**
+ * @brief Dessine le plateau dans un tampon, sans rien écrire sur la sortie.
+ *
+ * Le résultat est identique, octet par octet, à l'ancien affichage par
+ * `printf` : dessin ASCII des pièces, motifs des cases capturées, lettres et
+ * numéros des lignes, chiffre du joueur au trait. Les trois lignes de dessin
+ * de chaque aspect de case (vide, capturée par l'un ou l'autre joueur, chaque
+ * pièce de chaque joueur) sont préparées au premier appel puis recopiées par
+ * `memcpy` ; il en va de même pour la ligne des lettres de chaque dimension.
+ *
+ * @param state Pointeur vers l'état de jeu à dessiner.
+ * @param out Tampon d'au moins `RENDER_FRAME_SIZE` octets.
+ * @return size_t Le nombre d'octets écrits (sans zéro final).
+ */
+size_t render_board(const GameState *state, char *out);
+
+/**
+ * @brief Ce qui est actuellement affiché par `draw_board`.
+ *
+ * Le plateau occupe le haut de l'écran ; les lignes situées dessous forment
+ * une zone de défilement (séquence ANSI `DECSTBM`) réservée aux questions et
+ * messages, de sorte que le plateau ne se déplace jamais. Chaque case est
+ * mémorisée par son aspect (cf. `render_board`) pour ne redessiner que ce qui
+ * a changé.
+ */
+typedef struct {
+  bool valid;             ///< L'écran montre exactement `looks` et `turn`
+  bool ansi;              ///< La sortie est un terminal qui comprend l'ANSI
+  uint8_t dim;            ///< Dimension du plateau affiché
+  Player turn;            ///< Joueur dont le chiffre est affiché
+  uint16_t rows;          ///< Taille du terminal lors du dernier dessin
+  uint16_t columns;
+  uint8_t looks[BITBOARD_MAX_DIM][BITBOARD_MAX_DIM]; ///< Aspect de chaque case
+  char frame[RENDER_FRAME_SIZE]; ///< Tampon de sortie
+} ScreenRenderer;
+
+/**
+ * @brief Prépare l'affichage différentiel.
+ *
+ * Vérifie que la sortie standard est un terminal et, sous Windows, active le
+ * traitement des séquences ANSI de la console. Sinon, chaque appel à
+ * `draw_board` redessine tout, comme `print_board`.
+ *
+ * @param renderer Pointeur vers l'état d'affichage à initialiser.
+ */
+void init_screen_renderer(ScreenRenderer *renderer);
+
+/**
+ * @brief Affiche le plateau en ne réécrivant que les cases qui ont changé.
+ *
+ * Les cases dont l'aspect a changé depuis l'image précédente sont réécrites
+ * à leur place par positionnement du curseur, ainsi que le chiffre du joueur
+ * si le trait a changé ; la zone des questions est ensuite effacée et le
+ * curseur placé en haut de celle-ci. Le tout part en une seule écriture.
+ *
+ * L'écran est entièrement redessiné au premier appel, après
+ * `invalidate_screen`, si la dimension ou la taille du terminal a changé, ou
+ * si le terminal est trop petit pour garder le plateau et quelques lignes de
+ * questions à l'écran (le contenu défilerait et les positions seraient
+ * fausses).
+ *
+ * @param renderer Pointeur vers l'état d'affichage.
+ * @param state Pointeur vers l'état de jeu à afficher.
+ */
+void draw_board(ScreenRenderer *renderer, const GameState *state);
+
+/**
+ * @brief Signale que l'écran a été modifié hors de `draw_board`.
+ *
+ * Le prochain `draw_board` redessinera tout. Le joueur le demande par le
+ * choix « Redessiner l'écran » du menu de jeu, si l'affichage a été abîmé.
+ *
+ * @param renderer Pointeur vers l'état d'affichage.
+ */
+void invalidate_screen(ScreenRenderer *renderer);
+
+/**
+ * @brief Rend tout l'écran au texte normal (fin de la zone de défilement).
+ *
+ * À appeler avant d'afficher autre chose que les questions d'un tour.
+ * Invalide également l'écran.
+ *
+ * @param renderer Pointeur vers l'état d'affichage.
+ */
+void release_screen(ScreenRenderer *renderer);
+
+#endif // RENDER_H
@@ -0,0 +1,25 @@
+#include "rng.h"
+
+Rng init_rng(const uint64_t seed) {
+  // Mélange splitmix64 de la graine : évite l'état nul interdit par xorshift
+  uint64_t z = seed + 0x9E3779B97F4A7C15ULL;
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+  z ^= z >> 31;
+
+  return (Rng){.state = z ? z : 0x9E3779B97F4A7C15ULL};
+}
+
+uint64_t rng_next(Rng *rng) {
+  uint64_t x = rng->state;
+  x ^= x >> 12;
+  x ^= x << 25;
+  x ^= x >> 27;
+  rng->state = x;
+  return x * 0x2545F4914F6CDD1DULL;
+}
+
+uint32_t rng_below(Rng *rng, const uint32_t bound) {
+  // Multiplication 32 x 32 -> 64 bits : plus rapide qu'un modulo
+  return (uint32_t)(((rng_next(rng) >> 32) * (uint64_t)bound) >> 32);
+}
@@ -0,0 +1,41 @@
+#ifndef RNG_H
+#define RNG_H
+#include <stdint.h>
+
+/**
+ * @brief Générateur pseudo-aléatoire xorshift64*, à état explicite.
+ *
+ * Contrairement à `rand()`, chaque utilisateur (moteur, thread, partie)
+ * possède son propre état : les tirages sont reproductibles à partir de la
+ * graine et ne sont pas partagés entre threads.
+ */
+typedef struct {
+  uint64_t state;
+} Rng;
+
+/**
+ * @brief Initialise un générateur à partir d'une graine quelconque.
+ *
+ * @param seed La graine (0 est accepté).
+ * @return Rng Le générateur initialisé.
+ */
+Rng init_rng(uint64_t seed);
+
+/**
+ * @brief Tire un entier de 64 bits.
+ *
+ * @param rng Pointeur vers le générateur.
+ * @return uint64_t Le nombre tiré.
+ */
+uint64_t rng_next(Rng *rng);
+
+/**
+ * @brief Tire un entier dans l'intervalle [0, bound).
+ *
+ * @param rng Pointeur vers le générateur.
+ * @param bound La borne exclue (strictement positive).
+ * @return uint32_t Le nombre tiré.
+ */
+uint32_t rng_below(Rng *rng, uint32_t bound);
+
+#endif // RNG_H
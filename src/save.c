@@ -1,19 +1,150 @@
-
-#include "game_state.h"
+#include "save.h"
 #include "piece.h"
+#include <assert.h>
+#include "zobrist.h"
+#include <errno.h>
 #include <stdbool.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
-const char *FILENAME = "savegame.dat";
+#ifdef _WIN32
+#include <io.h>
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// Octet d'une case dans le format binaire
+#define TILE_KIND_MASK 0x07
+#define TILE_PIECE_PLAYER 0x08
+#define TILE_OCCUPIED 0x10
+#define TILE_CAPTURED 0x20
+#define TILE_CAPTURED_PLAYER 0x40
+
+// Position des champs de l'en-tête binaire
+#define HEADER_VERSION 4
+#define HEADER_MODE 5
+#define HEADER_WHITE 6
+#define HEADER_TURN 7
+#define HEADER_DIM 8
+#define HEADER_COUNTERS 9 // 6 octets par joueur
+
+const char *FILENAME = SAVE_FILENAME;
+
+// Mot du format texte et sa longueur, pour copier sans `strlen`
+typedef struct {
+  const char *text;
+  uint8_t length;
+} Token;
+
+#define TOKEN(literal) {literal, sizeof(literal) - 1}
+
+static const Token mode_tokens[2] = {TOKEN("Conquest"), TOKEN("Connect")};
+static const Token player_tokens[2] = {TOKEN("User"), TOKEN("Opponent")};
+static const Token piece_tokens[6] = {TOKEN("King"),   TOKEN("Queen"),
+                                      TOKEN("Rook"),   TOKEN("Bishop"),
+                                      TOKEN("Knight"), TOKEN("Pawn")};
+
+static char *put(char *cursor, const char *text, const size_t length) {
+  memcpy(cursor, text, length);
+  return cursor + length;
+}
+
+static char *put_token(char *cursor, const Token token) {
+  return put(cursor, token.text, token.length);
+}
 
-const int MAX_GAME_STATE_STR_LEN =
-    9 +                   // strlen("Conquest ")
-    5 +                   // strlen("User ")
-    3 +                   // longueur de dim (2 digits et un espace)
-    (12 * 12 * 10) +      // 12 (max dim) et 10 pour chaque piece
-    100;                  // securité
+size_t serialized_size(const GameState *state) {
+  const BoardPlanes *planes = &state->board.planes;
+  const uint8_t dim = state->board.dim;
+  const size_t tiles = (size_t)dim * dim;
+
+  // En-tête : "mode=", "white=", "turn=", "dim=", "tiles=" et 4 fins de ligne
+  size_t size = 5 + 6 + 5 + 4 + 6 + 4 +
+                mode_tokens[state->mode == Conquest ? 0 : 1].length +
+                player_tokens[state->is_white].length +
+                player_tokens[state->is_turn_of].length + (dim >= 10 ? 2 : 1);
+
+  // Chaque case : une espace et deux ':' ; "_" pour chaque champ absent
+  size += tiles * 3;
+  const size_t occupied = (size_t)bb_popcount(planes->occupied);
+  for (PieceKind kind = King; kind <= Pawn; ++kind)
+    size += (size_t)bb_popcount(planes->by_kind[kind]) *
+            piece_tokens[kind].length;
+  for (Player player = User; player <= Opponent; ++player) {
+    size += (size_t)bb_popcount(planes->by_player[player]) *
+            player_tokens[player].length;
+  }
+  size += 2 * (tiles - occupied);
+
+  size_t captured = 0;
+  for (Player player = User; player <= Opponent; ++player) {
+    const size_t count = (size_t)bb_popcount(planes->captured_by[player]);
+    size += count * player_tokens[player].length;
+    captured += count;
+  }
+  size += tiles - captured;
+
+  return size + 1; // fin de ligne finale
+}
+
+size_t serialize_to_buffer(const GameState *state, char *out,
+                           const size_t capacity) {
+  const size_t size = serialized_size(state);
+  if (capacity <= size)
+    return size;
+
+  const uint8_t dim = state->board.dim;
+  char *cursor = out;
+
+  cursor = put(cursor, "mode=", 5);
+  cursor = put_token(cursor, mode_tokens[state->mode == Conquest ? 0 : 1]);
+  cursor = put(cursor, "\nwhite=", 7);
+  cursor = put_token(cursor, player_tokens[state->is_white]);
+  cursor = put(cursor, "\nturn=", 6);
+  cursor = put_token(cursor, player_tokens[state->is_turn_of]);
+  cursor = put(cursor, "\ndim=", 5);
+  if (dim >= 10)
+    *cursor++ = (char)('0' + dim / 10);
+  *cursor++ = (char)('0' + dim % 10);
+  cursor = put(cursor, "\ntiles=", 7);
+
+  for (uint8_t i = 0; i < dim; i++) {
+    const Tile *row = state->board.tiles[i];
+    for (uint8_t j = 0; j < dim; j++) {
+      const Tile tile = row[j];
+
+      *cursor++ = ' ';
+      if (tile.some) {
+        cursor = put_token(cursor, piece_tokens[tile.value.kind]);
+        *cursor++ = ':';
+        cursor = put_token(cursor, player_tokens[tile.value.player]);
+      } else {
+        cursor = put(cursor, "_:_", 3);
+      }
+      *cursor++ = ':';
+      if (tile.captured_by.some)
+        cursor = put_token(cursor, player_tokens[tile.captured_by.player]);
+      else
+        *cursor++ = '_';
+    }
+  }
+  *cursor++ = '\n';
+  *cursor = '\0';
+
+  assert((size_t)(cursor - out) == size);
+  return size;
+}
+
+bool serialize_to_file(const GameState *state, FILE *file) {
+  char buffer[SERIALIZE_MAX_SIZE + 1];
+  const size_t size = serialize_to_buffer(state, buffer, sizeof(buffer));
+  return fwrite(buffer, 1, size, file) == size;
+}
 
 /**
  * @brief Sérialise un `GameState` sous forme de chaîne lisible.
@@ -29,323 +160,578 @@ const int MAX_GAME_STATE_STR_LEN =
  * @return char* Chaîne allouée dynamiquement. À libérer avec `free()`.
  */
 char *serialize(const GameState *state) {
-  char *str = malloc(MAX_GAME_STATE_STR_LEN);
+  const size_t size = serialized_size(state);
+  char *str = malloc(size + 1);
   if (!str) {
     perror("malloc failed");
     exit(EXIT_FAILURE);
   }
 
-  str[0] = '\0'; // Init buffer
-
-  const char *mode_str = (state->mode == Conquest) ? "Conquest" : "Connect";
-  snprintf(str, MAX_GAME_STATE_STR_LEN,
-           "mode=%s\nwhite=%s\nturn=%s\ndim=%d\ntiles=", mode_str,
-           stringify_player(state->is_white),
-           stringify_player(state->is_turn_of), state->board.dim);
-
-  for (uint8_t i = 0; i < state->board.dim; i++) {
-    for (uint8_t j = 0; j < state->board.dim; j++) {
-      strcat(str, " ");
-      const Tile tile = state->board.tiles[i][j];
+  serialize_to_buffer(state, str, size + 1);
+  return str;
+}
 
-      strcat(str, tile.some ? stringify_piece(tile.value.kind) : "_");
-      strcat(str, ":");
-      strcat(str, tile.some ? stringify_player(tile.value.player) : "_");
-      strcat(str, ":");
-      strcat(str, tile.captured_by.some
-                      ? stringify_player_option(tile.captured_by)
-                      : "_");
-    }
+static unsigned char encode_tile(const Tile tile) {
+  unsigned char byte = 0;
+  if (tile.some) {
+    byte |= TILE_OCCUPIED | (unsigned char)tile.value.kind;
+    if (tile.value.player == Opponent)
+      byte |= TILE_PIECE_PLAYER;
   }
-
-  strcat(str, "\n");
-
-  return str;
+  if (tile.captured_by.some) {
+    byte |= TILE_CAPTURED;
+    if (tile.captured_by.player == Opponent)
+      byte |= TILE_CAPTURED_PLAYER;
+  }
+  return byte;
 }
 
-// Représente le résultat de la désérialisation
-typedef enum {
-  DESERIALIZE_SUCCESS = 0,
-  DESERIALIZE_NULL_INPUT,
-  DESERIALIZE_MEMORY_ERROR,
-  DESERIALIZE_INVALID_FORMAT,
-  DESERIALIZE_INVALID_DIMENSION,
-  DESERIALIZE_INVALID_MODE,
-  DESERIALIZE_INVALID_PLAYER,
-  DESERIALIZE_MISSING_TILES,
-  DESERIALIZE_INVALID_PIECE_COUNT
-} DeserializeResult;
-
-// Fonction utilitaire pour copier une chaîne de manière sécurisée
-static bool safe_string_copy(char *dest, const char *src, size_t dest_size) {
-  if (!dest || !src || dest_size == 0)
-    return false;
+size_t serialize_binary(const GameState *state, unsigned char *out) {
+  const uint8_t dim = state->board.dim;
+
+  memset(out, 0, SAVE_BINARY_HEADER_SIZE);
+  memcpy(out, SAVE_BINARY_MAGIC, 4);
+  out[HEADER_VERSION] = SAVE_BINARY_VERSION;
+  out[HEADER_MODE] = (unsigned char)state->mode;
+  out[HEADER_WHITE] = (unsigned char)state->is_white;
+  out[HEADER_TURN] = (unsigned char)state->is_turn_of;
+  out[HEADER_DIM] = dim;
+  for (PieceKind kind = King; kind <= Pawn; ++kind) {
+    out[HEADER_COUNTERS + kind] = get_piece_count(&state->piece_counter_1, kind);
+    out[HEADER_COUNTERS + 6 + kind] =
+        get_piece_count(&state->piece_counter_2, kind);
+  }
 
-  const size_t src_len = strlen(src);
-  if (src_len >= dest_size)
-    return false;
+  unsigned char *tiles = out + SAVE_BINARY_HEADER_SIZE;
+  for (uint8_t i = 0; i < dim; i++) {
+    for (uint8_t j = 0; j < dim; j++)
+      *tiles++ = encode_tile(state->board.tiles[i][j]);
+  }
 
-  strcpy(dest, src);
-  return true;
+  return (size_t)(tiles - out);
 }
 
-// Fonction utilitaire pour analyser une ligne et extraire un champ spécifique
-static bool parse_field(const char *line, const char *prefix, char *output,
-                        size_t output_size) {
-  const size_t prefix_len = strlen(prefix);
-  if (strncmp(line, prefix, prefix_len) != 0)
-    return false;
+// Reconstruit un compteur à partir des six octets de l'en-tête ; `false` si
+// un nombre dépasse ce qu'il reste une fois les pièces du plateau posées
+static bool decode_counter(const unsigned char *bytes, const uint8_t *placed,
+                           PieceCountTracker *counter) {
+  const PieceCountTracker full = init_piece_counter();
+  for (PieceKind kind = King; kind <= Pawn; ++kind) {
+    if (placed[kind] + bytes[kind] > get_piece_count(&full, kind))
+      return false;
+  }
 
-  return safe_string_copy(output, line + prefix_len, output_size);
+  counter->king = bytes[King];
+  counter->queen = bytes[Queen];
+  counter->rooks = bytes[Rook];
+  counter->bishops = bytes[Bishop];
+  counter->knights = bytes[Knight];
+  counter->pawns = bytes[Pawn];
+  return true;
 }
 
-// Fonction utilitaire pour convertir une chaîne en énumération GameMode
-static bool string_to_mode(const char *mode_str, GameMode *mode) {
-  if (strcmp(mode_str, "Conquest") == 0) {
-    *mode = Conquest;
-    return true;
-  }
-  if (strcmp(mode_str, "Connect") == 0) {
-    *mode = Connect;
-    return true;
-  }
-  return false;
-}
+DeserializeResult deserialize_binary(const unsigned char *data,
+                                     const size_t size, GameState *state) {
+  if (!data || !state)
+    return DESERIALIZE_NULL_INPUT;
+  if (size < SAVE_BINARY_HEADER_SIZE || memcmp(data, SAVE_BINARY_MAGIC, 4) != 0)
+    return DESERIALIZE_INVALID_FORMAT;
+  if (data[HEADER_VERSION] != SAVE_BINARY_VERSION)
+    return DESERIALIZE_UNSUPPORTED_VERSION;
+
+  const unsigned char mode = data[HEADER_MODE];
+  const unsigned char white = data[HEADER_WHITE];
+  const unsigned char turn = data[HEADER_TURN];
+  const uint8_t dim = data[HEADER_DIM];
+  if (mode != Conquest && mode != Connect)
+    return DESERIALIZE_INVALID_MODE;
+  if ((white != User && white != Opponent) || (turn != User && turn != Opponent))
+    return DESERIALIZE_INVALID_PLAYER;
+  if (dim < 6 || dim > 12)
+    return DESERIALIZE_INVALID_DIMENSION;
+  if (size != SAVE_BINARY_HEADER_SIZE + (size_t)dim * dim)
+    return DESERIALIZE_MISSING_TILES;
 
-// Fonction utilitaire pour convertir une chaîne en énumération Player
-static bool string_to_player(const char *player_str, Player *player) {
-  if (strcmp(player_str, "User") == 0) {
-    *player = User;
-    return true;
-  }
-  if (strcmp(player_str, "Opponent") == 0) {
-    *player = Opponent;
-    return true;
+  // Vérifie les cases avant toute allocation
+  const unsigned char *tiles = data + SAVE_BINARY_HEADER_SIZE;
+  uint8_t placed[2][6] = {{0}};
+  for (size_t k = 0; k < (size_t)dim * dim; ++k) {
+    const unsigned char byte = tiles[k];
+    if (byte & 0x80)
+      return DESERIALIZE_INVALID_FORMAT;
+    if (byte & TILE_OCCUPIED) {
+      if ((byte & TILE_KIND_MASK) > Pawn)
+        return DESERIALIZE_INVALID_FORMAT;
+      placed[(byte & TILE_PIECE_PLAYER) ? Opponent : User]
+            [byte & TILE_KIND_MASK]++;
+    } else if (byte & (TILE_KIND_MASK | TILE_PIECE_PLAYER)) {
+      return DESERIALIZE_INVALID_FORMAT;
+    }
+    if (!(byte & TILE_CAPTURED) && (byte & TILE_CAPTURED_PLAYER))
+      return DESERIALIZE_INVALID_FORMAT;
   }
-  return false;
-}
 
-// Fonction utilitaire pour convertir une chaîne en un Tile
-static DeserializeResult parse_tiles(const char *tiles_str, GameState *state,
-                                     uint8_t dim) {
-  const char *current = tiles_str;
-  char tile_buffer[32];
+  memset(state, 0, sizeof(GameState));
+  init_zobrist_keys();
+  state->mode = (GameMode)mode;
+  state->is_white = (Player)white;
+  state->is_turn_of = (Player)turn;
+  if (!decode_counter(data + HEADER_COUNTERS, placed[User],
+                      &state->piece_counter_1) ||
+      !decode_counter(data + HEADER_COUNTERS + 6, placed[Opponent],
+                      &state->piece_counter_2))
+    return DESERIALIZE_INVALID_PIECE_COUNT;
+
+  state->board = init_board(dim);
+  if (!state->board.tiles)
+    return DESERIALIZE_MEMORY_ERROR;
 
   for (uint8_t i = 0; i < dim; i++) {
     for (uint8_t j = 0; j < dim; j++) {
-      // Skip whitespace
-      while (*current == ' ' || *current == '\t')
-        current++;
-
-      // Read piece token
-      int k = 0;
-      while (*current && *current != ' ' && *current != '\t' &&
-             *current != '\n' && k < sizeof(tile_buffer) - 1) {
-        tile_buffer[k++] = *current++;
-      }
-      tile_buffer[k] = '\0';
-
-      // Découper tile_buf en 3 parties : piece, owner, captured
-      char *piece_str = strtok(tile_buffer, ":");
-      // se souvient de la chaine gràce à un pointeur static
-      char *owner_str = strtok(NULL, ":");
-      // recupere ce qu'il reste
-      char *captured_str = strtok(NULL, " ");
-
-      if (!piece_str || !owner_str || !captured_str) {
-        return DESERIALIZE_INVALID_FORMAT;
+      const unsigned char byte = *tiles++;
+      if (byte == 0)
+        continue;
+
+      Tile tile = {.some = false, .captured_by = no_player()};
+      if (byte & TILE_OCCUPIED) {
+        const ChessPiece piece = {
+            .kind = (PieceKind)(byte & TILE_KIND_MASK),
+            .player = (byte & TILE_PIECE_PLAYER) ? Opponent : User};
+        tile = tile_with_piece(piece);
       }
-
-      const Tile tile =
-          deserialize_tile(piece_str, owner_str, captured_str, true);
-      state->board.tiles[i][j] = tile;
+      if (byte & TILE_CAPTURED)
+        tile.captured_by =
+            player_option((byte & TILE_CAPTURED_PLAYER) ? Opponent : User);
+      set_game_tile(state, j, i, tile);
     }
   }
 
+  state->hash = compute_hash(state);
   return DESERIALIZE_SUCCESS;
 }
 
-/**
- * @brief Fonction de désérialisation sécurisée d'une chaîne de caractères en un
- * état de jeu.
- *
- * Cette fonction prend une chaîne de caractères représentant l'état du jeu et
- * la convertit en une structure `GameState`. Elle gère les erreurs potentielles
- * et retourne un code d'erreur approprié.
- *
- * @param str La chaîne de caractères à désérialiser.
- * @param state Pointeur vers l'état du jeu à remplir.
- * @return DeserializeResult Le résultat de la désérialisation.
- */
-DeserializeResult deserialize_safe(const char *str, GameState *state) {
-  // Vérification des entrées
-  if (!str || !state) {
-    return DESERIALIZE_NULL_INPUT;
+// Lecture du format texte : un curseur avance sur l'entrée, sans copie
+typedef struct {
+  const char *start;
+  const char *cursor;
+  const char *end;
+} TextParser;
+
+// Champs d'en-tête rencontrés
+#define FIELD_MODE 1
+#define FIELD_WHITE 2
+#define FIELD_TURN 4
+#define FIELD_DIM 8
+#define FIELD_ALL 15
+
+static bool is_blank(const char c) {
+  return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
+
+// Compare `word` (en minuscules pour `ignore_case`) aux n octets de `text`
+static bool word_equals(const char *text, const size_t n, const char *word,
+                        const bool ignore_case) {
+  size_t i = 0;
+  for (; i < n && word[i]; ++i) {
+    char c = text[i];
+    if (ignore_case && c >= 'A' && c <= 'Z')
+      c = (char)(c - 'A' + 'a');
+    if (c != word[i])
+      return false;
   }
+  return i == n && word[i] == '\0';
+}
 
-  // Initialisation de l'état du jeu
-  memset(state, 0, sizeof(GameState));
+// Lit le reste de la ligne (sans "\r\n") et place le curseur après celle-ci
+static size_t take_line(TextParser *parser, const char **value) {
+  const char *line = parser->cursor;
+  const char *newline = memchr(line, '\n', (size_t)(parser->end - line));
+  const char *stop = newline ? newline : parser->end;
+
+  parser->cursor = newline ? newline + 1 : parser->end;
+  if (stop > line && stop[-1] == '\r')
+    stop--;
+  *value = line;
+  return (size_t)(stop - line);
+}
 
-  // Dupliquer la chaîne pour éviter de modifier l'original
-  // car strtok risque de la modifier
-  char *dup = strdup(str);
-  if (!dup) {
-    return DESERIALIZE_MEMORY_ERROR;
+// "User", "Opponent", "_" ou "None" : aiguillage sur la première lettre
+static bool parse_player(const char *text, const size_t n,
+                         PlayerOption *player) {
+  if (n == 0)
+    return false;
+  switch (text[0]) {
+  case 'N':
+    *player = no_player();
+    return word_equals(text, n, "None", false);
+  case 'U':
+    *player = player_option(User);
+    return word_equals(text, n, "User", false);
+  case 'O':
+    *player = player_option(Opponent);
+    return word_equals(text, n, "Opponent", false);
+  case '_':
+    *player = no_player();
+    return n == 1;
+  default:
+    return false;
+  }
+}
+
+// Nom de pièce, sans tenir compte de la casse, en anglais ou en français ;
+// "_" ou "None" pour une case vide (`*kind` vaut alors -1)
+static bool parse_piece(const char *text, const size_t n, int *kind) {
+  *kind = -1;
+  if (n == 0)
+    return false;
+  if (text[0] == '_')
+    return n == 1;
+
+  switch (text[0] | 0x20) { // minuscule pour les lettres
+  case 'n':
+    return word_equals(text, n, "none", true);
+  case 'k':
+    *kind = n == 4 ? King : Knight;
+    return word_equals(text, n, n == 4 ? "king" : "knight", true);
+  case 'q':
+    *kind = Queen;
+    return word_equals(text, n, "queen", true);
+  case 'd':
+    *kind = Queen;
+    return word_equals(text, n, "dame", true);
+  case 'r':
+    // Rook, Roi, Reine
+    if (n == 5) {
+      *kind = Queen;
+      return word_equals(text, n, "reine", true);
+    }
+    *kind = n == 3 ? King : Rook;
+    return word_equals(text, n, n == 3 ? "roi" : "rook", true);
+  case 't':
+    *kind = Rook;
+    return word_equals(text, n, "tour", true);
+  case 'b':
+    *kind = Bishop;
+    return word_equals(text, n, "bishop", true);
+  case 'f':
+    *kind = Bishop;
+    return word_equals(text, n, "fou", true);
+  case 'c':
+    *kind = Knight;
+    return word_equals(text, n, "cavalier", true);
+  case 'p':
+    // Pawn, Pion
+    *kind = Pawn;
+    return word_equals(text, n, "pawn", true) ||
+           word_equals(text, n, "pion", true);
+  default:
+    return false;
   }
+}
 
-  // variables pour stocker les champs d'en-tête
-  char mode_str[16] = {0};
-  char white_str[16] = {0};
-  char turn_str[16] = {0};
-  int dim = 0;
-  int parsed_fields = 0;
-
-  // On parse les lignes d'en-tête une à une
-  const char *line = strtok(dup, "\n");
-  while (line && parsed_fields < 4) {
-    if (parse_field(line, "mode=", mode_str, sizeof(mode_str))) {
-      parsed_fields++;
-    } else if (parse_field(line, "white=", white_str, sizeof(white_str))) {
-      parsed_fields++;
-    } else if (parse_field(line, "turn=", turn_str, sizeof(turn_str))) {
-      parsed_fields++;
-    } else if (strncmp(line, "dim=", 4) == 0) {
-      if (line[4] < '0' || line[4] > '9') {
-        free(dup);
+// Lit l'en-tête jusqu'à la ligne "tiles=", qui est consommée
+static DeserializeResult parse_header(TextParser *parser, GameState *state,
+                                      uint8_t *dim) {
+  unsigned fields = 0;
+
+  while (parser->cursor < parser->end) {
+    const char *line = parser->cursor;
+    const char *value;
+    size_t n;
+
+    switch (line[0]) {
+    case 'm':
+      if (parser->end - line < 5 || memcmp(line, "mode=", 5) != 0)
+        break;
+      parser->cursor += 5;
+      n = take_line(parser, &value);
+      if (word_equals(value, n, "Conquest", false))
+        state->mode = Conquest;
+      else if (word_equals(value, n, "Connect", false))
+        state->mode = Connect;
+      else {
+        parser->cursor = value;
+        return DESERIALIZE_INVALID_MODE;
+      }
+      fields |= FIELD_MODE;
+      continue;
+    case 'w':
+    case 't': {
+      const bool white = line[0] == 'w';
+      if (!white && parser->end - line >= 6 && memcmp(line, "tiles=", 6) == 0) {
+        parser->cursor += 6;
+        return fields == FIELD_ALL ? DESERIALIZE_SUCCESS
+                                   : DESERIALIZE_INVALID_FORMAT;
+      }
+      const char *prefix = white ? "white=" : "turn=";
+      const size_t prefix_length = white ? 6 : 5;
+      if ((size_t)(parser->end - line) < prefix_length ||
+          memcmp(line, prefix, prefix_length) != 0)
+        break;
+      parser->cursor += prefix_length;
+      n = take_line(parser, &value);
+      PlayerOption player;
+      if (!parse_player(value, n, &player) || !player.some) {
+        parser->cursor = value;
+        return DESERIALIZE_INVALID_PLAYER;
+      }
+      if (white)
+        state->is_white = player.player;
+      else
+        state->is_turn_of = player.player;
+      fields |= white ? FIELD_WHITE : FIELD_TURN;
+      continue;
+    }
+    case 'd': {
+      if (parser->end - line < 4 || memcmp(line, "dim=", 4) != 0)
+        break;
+      parser->cursor += 4;
+      n = take_line(parser, &value);
+      unsigned number = 0;
+      for (size_t i = 0; i < n; ++i) {
+        if (value[i] < '0' || value[i] > '9' || i >= 2) {
+          parser->cursor = value + i;
+          return DESERIALIZE_INVALID_FORMAT;
+        }
+        number = number * 10 + (unsigned)(value[i] - '0');
+      }
+      if (n == 0) {
+        parser->cursor = value;
         return DESERIALIZE_INVALID_FORMAT;
       }
-      dim = atoi(line + 4);
-      if (dim < 6 || dim > 12) {
-        free(dup);
+      if (number < 6 || number > 12) {
+        parser->cursor = value;
         return DESERIALIZE_INVALID_DIMENSION;
       }
-      parsed_fields++;
-    } else if (strncmp(line, "tiles=", 6) == 0) {
-      break; // Section des tuiles trouvée, arrêt de l'analyse des en-têtes
+      *dim = (uint8_t)number;
+      fields |= FIELD_DIM;
+      continue;
+    }
+    default:
+      break;
     }
-    line = strtok(NULL, "\n");
-  }
-
-  // Vérifie que tous les champs requis ont été trouvés
-  if (parsed_fields != 4) {
-    free(dup);
-    return DESERIALIZE_INVALID_FORMAT;
-  }
-
-  // Convertit les chaînes en énumérations avec validation
-  if (!string_to_mode(mode_str, &state->mode)) {
-    free(dup);
-    return DESERIALIZE_INVALID_MODE;
-  }
-
-  if (!string_to_player(white_str, &state->is_white)) {
-    free(dup);
-    return DESERIALIZE_INVALID_PLAYER;
-  }
-
-  if (!string_to_player(turn_str, &state->is_turn_of)) {
-    free(dup);
-    return DESERIALIZE_INVALID_PLAYER;
-  }
-
-  // Initialize board
-  state->board = init_board((uint8_t)dim);
-  if (!state->board.tiles) {
-    free(dup);
-    return DESERIALIZE_MEMORY_ERROR;
-  }
 
-  // on s'occupe de la section des tiles
-  const char *tiles_line = strstr(str, "tiles=");
-  if (!tiles_line) {
-    free(dup);
-    free_board(&state->board);
-    return DESERIALIZE_MISSING_TILES;
+    // Ligne inconnue : ignorée
+    take_line(parser, &value);
   }
 
-  tiles_line += 6; // On saute "tiles="
-  const DeserializeResult tiles_result =
-      parse_tiles(tiles_line, state, (uint8_t)dim);
-
-  free(dup);
+  return fields == FIELD_ALL ? DESERIALIZE_MISSING_TILES
+                             : DESERIALIZE_INVALID_FORMAT;
+}
 
-  if (tiles_result != DESERIALIZE_SUCCESS) {
-    free_board(&state->board);
+// Lit dim x dim cases "pièce:joueur:capturée" séparées par des blancs
+static DeserializeResult parse_tiles(TextParser *parser, GameState *state,
+                                     const uint8_t dim) {
+  const char *end = parser->end;
 
-    return tiles_result;
-  }
+  for (uint8_t i = 0; i < dim; i++) {
+    for (uint8_t j = 0; j < dim; j++) {
+      const char *c = parser->cursor;
+      while (c < end && is_blank(*c))
+        c++;
+      parser->cursor = c;
+      if (c == end)
+        return DESERIALIZE_MISSING_TILES;
+
+      // Trois champs séparés par ':', la case s'arrête au premier blanc
+      const char *field[3];
+      size_t length[3];
+      for (int k = 0; k < 3; ++k) {
+        field[k] = c;
+        while (c < end && *c != ':' && !is_blank(*c))
+          c++;
+        length[k] = (size_t)(c - field[k]);
+        if (k < 2) {
+          if (c == end || *c != ':') {
+            parser->cursor = c;
+            return DESERIALIZE_INVALID_FORMAT;
+          }
+          c++;
+        }
+      }
 
-  // Initialisation de piece counters, et on restaure son état
-  state->piece_counter_1 = init_piece_counter();
-  state->piece_counter_2 = init_piece_counter();
+      int kind;
+      PlayerOption owner, captured;
+      if (!parse_piece(field[0], length[0], &kind)) {
+        parser->cursor = field[0];
+        return DESERIALIZE_INVALID_FORMAT;
+      }
+      if (!parse_player(field[1], length[1], &owner) ||
+          (kind >= 0 && !owner.some)) {
+        parser->cursor = field[1];
+        return DESERIALIZE_INVALID_PLAYER;
+      }
+      if (!parse_player(field[2], length[2], &captured)) {
+        parser->cursor = field[2];
+        return DESERIALIZE_INVALID_PLAYER;
+      }
 
-  for (uint8_t i = 0; i < state->board.dim; i++) {
-    for (uint8_t j = 0; j < state->board.dim; j++) {
-      const Tile tile = state->board.tiles[i][j];
-      if (tile.some) {
-        PieceCountTracker *counter = (tile.value.player == User)
+      Tile tile = empty_tile();
+      if (kind >= 0) {
+        PieceCountTracker *counter = owner.player == User
                                          ? &state->piece_counter_1
                                          : &state->piece_counter_2;
-        const bool result = add_piece(counter, tile.value.kind);
-
-        if (!result) {
-          // Si on n'a pas pu ajouter la pièce, on libère le plateau et retourne
-          // une erreur Cela peut arriver si le nombre de pièces sur le plateau
-          // dépasse la limite autorisée
-          free_board(&state->board);
+        // Plus de pièces de ce type sur le plateau que le joueur n'en a
+        if (!add_piece(counter, (PieceKind)kind))
           return DESERIALIZE_INVALID_PIECE_COUNT;
-        }
+        tile = tile_with_piece(
+            (ChessPiece){.kind = (PieceKind)kind, .player = owner.player});
       }
+      tile.captured_by = captured;
+      if (tile.some || captured.some)
+        set_game_tile(state, j, i, tile);
+
+      parser->cursor = c;
     }
   }
 
   return DESERIALIZE_SUCCESS;
 }
 
-// Fonction qui gère la désérialisation d'une chaîne de caractères en un
-// `GameState` avec gestion des erreurs
-GameState deserialize(const char *str) {
-  GameState state;
-  const DeserializeResult result = deserialize_safe(str, &state);
+DeserializeResult parse_game_text(const char *text, const size_t length,
+                                  GameState *state, size_t *error_offset) {
+  if (!text || !state)
+    return DESERIALIZE_NULL_INPUT;
+
+  memset(state, 0, sizeof(GameState));
+  init_zobrist_keys();
+
+  TextParser parser = {.start = text, .cursor = text, .end = text + length};
+  uint8_t dim = 0;
+  DeserializeResult result = parse_header(&parser, state, &dim);
+
+  if (result == DESERIALIZE_SUCCESS) {
+    state->board = init_board(dim);
+    if (!state->board.tiles)
+      return DESERIALIZE_MEMORY_ERROR;
+
+    state->piece_counter_1 = init_piece_counter();
+    state->piece_counter_2 = init_piece_counter();
+    result = parse_tiles(&parser, state, dim);
+    if (result != DESERIALIZE_SUCCESS)
+      free_board(&state->board);
+  }
 
   if (result != DESERIALIZE_SUCCESS) {
-    // Messages d'erreur associés aux codes
-    const char *error_messages[] = {
-        "Succès",
-        "L'entrée est NULL",
-        "Échec de l'allocation mémoire",
-        "Format invalide ou champs requis manquants",
-        "Dimension invalide (doit être comprise entre 6 et 12)",
-        "Mode de jeu invalide",
-        "Spécification de joueur invalide",
-        "Section des tuiles manquante",
-        "Nombre de pièces capturées dépassant les limites autorisées"};
-
-    printf("Erreur de désérialisation : %s\n", error_messages[result]);
-    exit(EXIT_FAILURE);
+    if (error_offset)
+      *error_offset = (size_t)(parser.cursor - parser.start);
+    return result;
   }
 
-  return state;
+  state->hash = compute_hash(state);
+  return DESERIALIZE_SUCCESS;
 }
 
-bool save_game(const GameState *state) {
-  FILE *file = fopen(FILENAME, "w");
-  if (!file) {
-    perror("Échec de l'ouverture du fichier pour la sauvegarde");
+DeserializeResult deserialize_safe(const char *str, GameState *state) {
+  if (!str)
+    return DESERIALIZE_NULL_INPUT;
+  return parse_game_text(str, strlen(str), state, NULL);
+}
+
+const char *deserialize_error_message(const DeserializeResult result) {
+  // Messages d'erreur associés aux codes
+  static const char *error_messages[] = {
+      "Succès",
+      "L'entrée est NULL",
+      "Échec de l'allocation mémoire",
+      "Format invalide ou champs requis manquants",
+      "Dimension invalide (doit être comprise entre 6 et 12)",
+      "Mode de jeu invalide",
+      "Spécification de joueur invalide",
+      "Section des tuiles manquante",
+      "Nombre de pièces capturées dépassant les limites autorisées",
+      "Lecture du fichier impossible",
+      "Version de sauvegarde non prise en charge",
+      "Coup impossible dans cette position"};
+
+  return error_messages[result];
+}
+
+// Force l'écriture sur le disque du contenu d'un fichier ouvert
+static bool sync_file(FILE *file) {
+  if (fflush(file) != 0)
     return false;
+#ifdef _WIN32
+  return _commit(_fileno(file)) == 0;
+#else
+  return fsync(fileno(file)) == 0;
+#endif
+}
+
+// Rend durable le renommage d'un fichier du répertoire de `path`
+static void sync_parent_directory(const char *path) {
+#ifndef _WIN32
+  const char *slash = strrchr(path, '/');
+  char directory[FILENAME_MAX] = ".";
+  if (slash) {
+    const size_t length = slash == path ? 1 : (size_t)(slash - path);
+    if (length >= sizeof(directory))
+      return;
+    memcpy(directory, path, length);
+    directory[length] = '\0';
   }
 
-  char *serialized = serialize(state);
+  const int fd = open(directory, O_RDONLY);
+  if (fd >= 0) {
+    fsync(fd);
+    close(fd);
+  }
+#else
+  (void)path; // MOVEFILE_WRITE_THROUGH suffit
+#endif
+}
 
-  if (fprintf(file, "%s", serialized) < 0) {
-    perror("Échec de l'écriture dans le fichier");
-    free(serialized);
-    fclose(file);
+bool write_save_file(const char *path, const unsigned char *data,
+                     const size_t size) {
+  char temp[FILENAME_MAX];
+  if (snprintf(temp, sizeof(temp), "%s.tmp", path) >= (int)sizeof(temp)) {
+    errno = ENAMETOOLONG;
     return false;
   }
 
-  free(serialized);
-  fclose(file);
+  FILE *file = fopen(temp, "wb");
+  if (!file)
+    return false;
+
+  bool written = fwrite(data, 1, size, file) == size && sync_file(file);
+  int error = errno;
+  if (fclose(file) != 0 && written) {
+    written = false;
+    error = errno;
+  }
+
+#ifdef _WIN32
+  if (written && !MoveFileExA(temp, path,
+                              MOVEFILE_REPLACE_EXISTING |
+                                  MOVEFILE_WRITE_THROUGH)) {
+    written = false;
+    error = EIO;
+  }
+#else
+  if (written && rename(temp, path) != 0) {
+    written = false;
+    error = errno;
+  }
+#endif
+
+  if (!written) {
+    // L'ancienne sauvegarde est intacte : seul le fichier temporaire part
+    remove(temp);
+    errno = error;
+    return false;
+  }
+  sync_parent_directory(path);
+  return true;
+}
+
+bool save_game(const GameState *state) {
+  unsigned char buffer[SAVE_BINARY_MAX_SIZE];
+  const size_t size = serialize_binary(state, buffer);
+
+  if (!write_save_file(FILENAME, buffer, size)) {
+    perror("Échec de l'écriture de la sauvegarde");
+    return false;
+  }
   return true;
 }
 
@@ -358,33 +744,89 @@ bool save_file_exists() {
   return false;
 }
 
-GameState load_game() {
-  FILE *file = fopen(FILENAME, "r");
-  if (!file) {
-    perror("Erreur lors de l'ouverture du fichier de sauvegarde");
-    exit(EXIT_FAILURE);
+bool map_file(const char *path, MappedFile *mapped) {
+#ifdef _WIN32
+  const HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL,
+                                  OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+  if (file == INVALID_HANDLE_VALUE)
+    return false;
+
+  LARGE_INTEGER size;
+  if (!GetFileSizeEx(file, &size) || size.QuadPart == 0) {
+    CloseHandle(file);
+    return false;
   }
+  mapped->size = (size_t)size.QuadPart;
+  mapped->mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+  CloseHandle(file);
+  if (!mapped->mapping)
+    return false;
 
-  char *buffer = malloc(MAX_GAME_STATE_STR_LEN);
-  if (!buffer) {
-    perror("Échec de l'allocation mémoire");
-    fclose(file);
-    exit(EXIT_FAILURE);
+  mapped->data = MapViewOfFile(mapped->mapping, FILE_MAP_READ, 0, 0, 0);
+  if (!mapped->data) {
+    CloseHandle(mapped->mapping);
+    return false;
   }
+#else
+  const int fd = open(path, O_RDONLY);
+  if (fd < 0)
+    return false;
 
-  const size_t total_read =
-      fread(buffer, sizeof(char), MAX_GAME_STATE_STR_LEN - 1, file);
-  if (ferror(file)) {
-    perror("Erreur lors de la lecture du fichier de sauvegarde");
-    free(buffer);
-    fclose(file);
-    exit(EXIT_FAILURE);
+  struct stat info;
+  if (fstat(fd, &info) != 0 || info.st_size == 0) {
+    close(fd);
+    return false;
+  }
+  mapped->size = (size_t)info.st_size;
+  void *data = mmap(NULL, mapped->size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd); // la projection reste valide
+  if (data == MAP_FAILED)
+    return false;
+  mapped->data = data;
+#endif
+  return true;
+}
+
+void unmap_file(const MappedFile *mapped) {
+#ifdef _WIN32
+  UnmapViewOfFile(mapped->data);
+  CloseHandle(mapped->mapping);
+#else
+  munmap((void *)mapped->data, mapped->size);
+#endif
+}
+
+DeserializeResult load_game_file(const char *path, GameState *state) {
+  MappedFile mapped;
+  if (!map_file(path, &mapped))
+    return DESERIALIZE_IO_ERROR;
+
+  DeserializeResult result;
+  if (mapped.size >= 4 && memcmp(mapped.data, SAVE_BINARY_MAGIC, 4) == 0) {
+    result = deserialize_binary(mapped.data, mapped.size, state);
+  } else {
+    // Ancien format texte, lu directement dans la projection
+    result = parse_game_text((const char *)mapped.data, mapped.size, state,
+                             NULL);
   }
 
-  buffer[total_read] = '\0';
-  fclose(file);
+  unmap_file(&mapped);
+  return result;
+}
+
+GameState load_game() {
+  GameState state;
+  const DeserializeResult result = load_game_file(FILENAME, &state);
+
+  if (result == DESERIALIZE_IO_ERROR) {
+    perror("Erreur lors de l'ouverture du fichier de sauvegarde");
+    exit(EXIT_FAILURE);
+  }
+  if (result != DESERIALIZE_SUCCESS) {
+    printf("Erreur de désérialisation : %s\n",
+           deserialize_error_message(result));
+    exit(EXIT_FAILURE);
+  }
 
-  const GameState state = deserialize(buffer);
-  free(buffer);
   return state;
 }
@@ -3,11 +3,180 @@
 #define SAVE_H
 #include "game_state.h"
 #include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+
+#define SAVE_FILENAME "savegame.dat" ///< Fichier de sauvegarde de la partie
+#define SAVE_BINARY_MAGIC "IF2B"   ///< Début de toute sauvegarde binaire
+#define SAVE_BINARY_VERSION 1      ///< Version écrite par `serialize_binary`
+#define SAVE_BINARY_HEADER_SIZE 24 ///< En-tête fixe, avant les cases
+/// Taille maximale d'une sauvegarde binaire (plateau 12x12)
+#define SAVE_BINARY_MAX_SIZE (SAVE_BINARY_HEADER_SIZE + 12 * 12)
+
+// Représente le résultat de la désérialisation
+typedef enum {
+  DESERIALIZE_SUCCESS = 0,
+  DESERIALIZE_NULL_INPUT,
+  DESERIALIZE_MEMORY_ERROR,
+  DESERIALIZE_INVALID_FORMAT,
+  DESERIALIZE_INVALID_DIMENSION,
+  DESERIALIZE_INVALID_MODE,
+  DESERIALIZE_INVALID_PLAYER,
+  DESERIALIZE_MISSING_TILES,
+  DESERIALIZE_INVALID_PIECE_COUNT,
+  DESERIALIZE_IO_ERROR,
+  DESERIALIZE_UNSUPPORTED_VERSION,
+  DESERIALIZE_ILLEGAL_MOVE
+} DeserializeResult;
+
+/**
+ * @brief Taille maximale du format texte, sans le zéro final : en-tête le
+ * plus long puis 144 cases " Knight:Opponent:Opponent" et la fin de ligne.
+ */
+#define SERIALIZE_MAX_SIZE (56 + 12 * 12 * 25 + 1)
+
+/**
+ * @brief Calcule la taille exacte du format texte d'un `GameState`.
+ *
+ * Le calcul ne parcourt pas le plateau : il compte les bits des plans de
+ * `BoardPlanes` et les multiplie par la longueur de chaque mot.
+ *
+ * @param state Pointeur vers l'état de jeu.
+ * @return size_t Le nombre d'octets, sans le zéro final.
+ */
+size_t serialized_size(const GameState *state);
+
+/**
+ * @brief Écrit le format texte dans le tampon de l'appelant.
+ *
+ * Chaque mot est recopié à la suite d'un curseur d'écriture, en une seule
+ * passe linéaire. Comme `snprintf`, la fonction renvoie la taille du texte ;
+ * si le tampon est trop petit (moins de `taille + 1` octets), rien n'est
+ * écrit.
+ *
+ * @param state Pointeur vers l'état de jeu à sérialiser.
+ * @param out Tampon de destination.
+ * @param capacity Taille du tampon.
+ * @return size_t La taille du texte, sans le zéro final.
+ */
+size_t serialize_to_buffer(const GameState *state, char *out, size_t capacity);
+
+/**
+ * @brief Écrit le format texte dans un fichier ouvert, d'un seul `fwrite`.
+ *
+ * @param state Pointeur vers l'état de jeu à sérialiser.
+ * @param file Le fichier de destination.
+ * @return bool `false` en cas d'erreur d'écriture.
+ */
+bool serialize_to_file(const GameState *state, FILE *file);
+
+/**
+ * @brief Sérialise un `GameState` dans le format de `savegame.dat`.
+ *
+ * @param state Pointeur vers l'état de jeu à sérialiser.
+ * @return char* Chaîne allouée dynamiquement, de la taille exacte donnée par
+ * `serialized_size`. À libérer avec `free()`.
+ */
+char *serialize(const GameState *state);
+
+/**
+ * @brief Écrit un `GameState` au format binaire.
+ *
+ * Format, tous les champs sur un octet :
+ * - 0 à 3 : `SAVE_BINARY_MAGIC` ; 4 : version ; 5 : mode (`GameMode`) ;
+ *   6 : joueur blanc ; 7 : joueur au trait (`Player`) ; 8 : dimension ;
+ * - 9 à 14 puis 15 à 20 : pièces restantes de User puis d'Opponent, dans
+ *   l'ordre de `PieceKind` ; 21 à 23 : zéro ;
+ * - puis une case par octet, ligne par ligne : bits 0 à 2 type de la pièce,
+ *   bit 3 joueur de la pièce, bit 4 case occupée, bit 5 case capturée,
+ *   bit 6 joueur qui l'a capturée. Une case vide et libre vaut 0.
+ *
+ * Contrairement au format texte, les compteurs de pièces sont enregistrés
+ * tels quels (ils ne se déduisent pas toujours du plateau, cf.
+ * `clear_piece_counters`).
+ *
+ * @param state Pointeur vers l'état de jeu à écrire.
+ * @param out Tampon d'au moins `SAVE_BINARY_MAX_SIZE` octets.
+ * @return size_t Le nombre d'octets écrits (`SAVE_BINARY_HEADER_SIZE + dim²`).
+ */
+size_t serialize_binary(const GameState *state, unsigned char *out);
+
+/**
+ * @brief Lit un `GameState` au format binaire de `serialize_binary`.
+ *
+ * Le décodage se fait directement depuis `data`, sans copie ni allocation
+ * autre que celle du plateau de l'état. Chaque champ est vérifié.
+ *
+ * @param data Les octets de la sauvegarde.
+ * @param size Leur nombre.
+ * @param state Pointeur vers l'état à remplir (à libérer avec
+ * `free_game_state` en cas de succès uniquement).
+ * @return DeserializeResult `DESERIALIZE_SUCCESS` ou la cause de l'échec.
+ */
+DeserializeResult deserialize_binary(const unsigned char *data, size_t size,
+                                     GameState *state);
+
+/**
+ * @brief Lit un `GameState` au format texte de `savegame.dat`.
+ *
+ * L'analyse se fait en une seule passe sur `text`, qui n'est ni copié ni
+ * modifié et n'a pas besoin d'être terminé par un zéro : un fichier projeté
+ * en mémoire peut être lu tel quel. Aucune allocation n'est faite en dehors
+ * du plateau de l'état. Les lignes d'en-tête peuvent venir dans n'importe
+ * quel ordre avant `tiles=` ; les lignes inconnues sont ignorées. Les cases
+ * sont séparées par des blancs (espaces, tabulations, fins de ligne).
+ *
+ * @param text Le texte à lire.
+ * @param length Son nombre d'octets.
+ * @param state Pointeur vers l'état à remplir (à libérer avec
+ * `free_game_state` en cas de succès uniquement).
+ * @param error_offset Si non NULL, reçoit en cas d'échec la position dans
+ * `text` de l'octet fautif.
+ * @return DeserializeResult `DESERIALIZE_SUCCESS` ou la cause de l'échec.
+ */
+DeserializeResult parse_game_text(const char *text, size_t length,
+                                  GameState *state, size_t *error_offset);
+
+/**
+ * @brief Désérialise une chaîne au format de `savegame.dat` terminée par un
+ * zéro, cf. `parse_game_text`.
+ *
+ * @param str La chaîne à désérialiser.
+ * @param state Pointeur vers l'état à remplir (à libérer avec
+ * `free_game_state` en cas de succès uniquement).
+ * @return DeserializeResult `DESERIALIZE_SUCCESS` ou la cause de l'échec.
+ */
+DeserializeResult deserialize_safe(const char *str, GameState *state);
+
+/**
+ * @brief Renvoie le message d'erreur associé à un résultat de désérialisation.
+ *
+ * @param result Le résultat à décrire.
+ * @return const char* Message statique, à ne pas libérer.
+ */
+const char *deserialize_error_message(DeserializeResult result);
+
+/**
+ * @brief Remplace un fichier de sauvegarde sans risque de le perdre.
+ *
+ * Les octets sont écrits dans `<path>.tmp`, forcés sur le disque (`fsync`)
+ * puis le fichier temporaire est renommé en `path`, ce qui remplace l'ancien
+ * fichier d'un coup : un arrêt à n'importe quel moment laisse soit
+ * l'ancienne sauvegarde, soit la nouvelle, jamais un fichier tronqué. Rien
+ * n'est affiché.
+ *
+ * @param path Le chemin du fichier.
+ * @param data Les octets à écrire.
+ * @param size Leur nombre.
+ * @return bool `false` en cas d'échec, avec `errno` renseigné.
+ */
+bool write_save_file(const char *path, const unsigned char *data, size_t size);
 
 /**
  * @brief Sauvegarde l'état actuel du jeu dans un fichier.
  *
- * Sérialise l'état du jeu et l'écrit dans un fichier nommé `savegame.dat`.
+ * Écrit l'état du jeu au format binaire (`serialize_binary`) dans un fichier
+ * nommé `savegame.dat`, avec `write_save_file`.
  *
  * @param state Un pointeur vers l'état de jeu à sauvegarder.
  * @return bool `true` si la sauvegarde a réussi, `false` sinon.
@@ -23,13 +192,56 @@ bool save_game(const GameState *state);
  */
 bool save_file_exists();
 
+/**
+ * @brief Fichier projeté en mémoire, en lecture seule (cf. `map_file`).
+ */
+typedef struct {
+  const unsigned char *data;
+  size_t size;
+#ifdef _WIN32
+  void *mapping; ///< `HANDLE` de la projection
+#endif
+} MappedFile;
+
+/**
+ * @brief Projette un fichier en mémoire (`mmap`, `MapViewOfFile` sous
+ * Windows), en lecture seule.
+ *
+ * @param path Le chemin du fichier.
+ * @param mapped Reçoit la projection, à libérer avec `unmap_file`.
+ * @return bool `false` si le fichier n'a pas pu être ouvert ou projeté, ou
+ * s'il est vide.
+ */
+bool map_file(const char *path, MappedFile *mapped);
+
+/**
+ * @brief Libère une projection faite par `map_file`.
+ *
+ * @param mapped Pointeur vers la projection.
+ */
+void unmap_file(const MappedFile *mapped);
+
+/**
+ * @brief Charge un état de jeu depuis un fichier, sans quitter le programme.
+ *
+ * Le fichier est projeté en mémoire (`mmap`). Une sauvegarde binaire est
+ * reconnue à son en-tête et décodée sur place ; sinon le contenu est lu
+ * comme une sauvegarde texte (anciens fichiers `savegame.dat`).
+ *
+ * @param path Le chemin du fichier.
+ * @param state Pointeur vers l'état à remplir (à libérer avec
+ * `free_game_state` en cas de succès uniquement).
+ * @return DeserializeResult `DESERIALIZE_SUCCESS` ou la cause de l'échec.
+ */
+DeserializeResult load_game_file(const char *path, GameState *state);
+
 /**
  * @brief Charge l'état du jeu à partir du fichier de sauvegarde.
  *
- * Cette fonction lit le contenu du fichier `savegame.dat`, désérialise les
- * données et retourne l'état du jeu correspondant. En cas d'erreur (fichier
- * introuvable, lecture ou allocation mémoire échouée), le programme s'arrête
- * avec un message d'erreur.
+ * Cette fonction lit le fichier `savegame.dat` avec `load_game_file`, au
+ * format binaire ou texte, et retourne l'état du jeu correspondant. En cas
+ * d'erreur (fichier introuvable, lecture ou allocation mémoire échouée), le
+ * programme s'arrête avec un message d'erreur.
  *
  * @return GameState L'état du jeu restauré depuis la sauvegarde.
  */
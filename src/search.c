@@ -0,0 +1,353 @@
+#include "search.h"
+#include "capture.h"
+#include "movegen.h"
+#include "thread.h"
+#include "timer.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+#define EVAL_OCCUPIED_WEIGHT 3 ///< Poids d'une case occupée capturée
+#define EVAL_EMPTY_WEIGHT 1    ///< Poids d'une case vide capturée
+
+// Bonus de tri (les gains en cases restent inférieurs à 256)
+#define ORDER_PREVIOUS_BEST 1000000
+#define ORDER_KILLER 10000
+
+// État interne d'une recherche, propre à chaque thread
+typedef struct {
+  GameState *state;
+  SearchLimits limits;
+  TranspositionTable *tt;      // Table partagée (NULL : aucune)
+  volatile uint64_t *stop_all; // Drapeau d'arrêt commun aux threads
+  uint64_t start_ms;
+  uint64_t nodes;
+  bool stopped;
+  uint8_t depth_offset; // Décalage de profondeur des threads auxiliaires
+  Move killers[SEARCH_MAX_PLY][2];
+} SearchContext;
+
+static bool same_move(const Move a, const Move b) {
+  return a.kind == b.kind && a.x == b.x && a.y == b.y;
+}
+
+int evaluate(const GameState *state) {
+  const Player me = state->is_turn_of;
+  const Player other = (me == User) ? Opponent : User;
+
+  return EVAL_OCCUPIED_WEIGHT *
+             (state->owned_occupied[me] - state->owned_occupied[other]) +
+         EVAL_EMPTY_WEIGHT * (state->owned_empty[me] - state->owned_empty[other]);
+}
+
+bool is_game_over(const GameState *state) {
+  return has_no_pieces_left(get_user_turn_count_tracker(state));
+}
+
+// Score d'une partie terminée : le nombre de cases occupées décide du
+// vainqueur ; en cas d'égalité, le territoire départage les parties nulles.
+static int final_score(const GameState *state) {
+  const Player me = state->is_turn_of;
+  const Player other = (me == User) ? Opponent : User;
+  const int diff = state->owned_occupied[me] - state->owned_occupied[other];
+
+  if (diff > 0)
+    return SCORE_WIN + diff;
+  if (diff < 0)
+    return -SCORE_WIN + diff;
+  return evaluate(state);
+}
+
+static bool time_is_up(SearchContext *ctx) {
+  if (ctx->stop_all && atomic_load_u64(ctx->stop_all))
+    return true;
+  if (ctx->limits.time_limit_ms == 0)
+    return false;
+  return now_ms() - ctx->start_ms >= ctx->limits.time_limit_ms;
+}
+
+// Donne une note à chaque coup pour les explorer du plus prometteur au moins
+// prometteur : cases gagnées par la capture, coups killer, meilleur coup connu.
+static void score_moves(const SearchContext *ctx, const Move *moves,
+                        int *scores, const size_t count, const int ply,
+                        const Move *first) {
+  const GameState *state = ctx->state;
+  const Player me = state->is_turn_of;
+  const BitBoard owned = state->board.planes.captured_by[me];
+
+  for (size_t i = 0; i < count; ++i) {
+    const ChessPiece piece = {.kind = (PieceKind)moves[i].kind, .player = me};
+    const BitBoard gain = bb_andnot(
+        conquest_capture_mask(&state->board, moves[i].x, moves[i].y, piece, me),
+        owned);
+    scores[i] = bb_popcount(gain);
+
+    if (first && same_move(moves[i], *first))
+      scores[i] += ORDER_PREVIOUS_BEST;
+    else if (same_move(moves[i], ctx->killers[ply][0]) ||
+             same_move(moves[i], ctx->killers[ply][1]))
+      scores[i] += ORDER_KILLER;
+  }
+}
+
+// Amène le meilleur coup restant en position `index` (tri par sélection)
+static void pick_move(Move *moves, int *scores, const size_t count,
+                      const size_t index) {
+  size_t best = index;
+  for (size_t i = index + 1; i < count; ++i) {
+    if (scores[i] > scores[best])
+      best = i;
+  }
+
+  const Move move = moves[index];
+  const int score = scores[index];
+  moves[index] = moves[best];
+  scores[index] = scores[best];
+  moves[best] = move;
+  scores[best] = score;
+}
+
+static int negamax(SearchContext *ctx, const int depth, const int ply,
+                   int alpha, int beta) {
+  GameState *state = ctx->state;
+
+  ctx->nodes++;
+  if ((ctx->nodes & 1023) == 0 && time_is_up(ctx))
+    ctx->stopped = true;
+  if (ctx->stopped)
+    return 0;
+
+  if (is_game_over(state))
+    return final_score(state);
+  if (depth <= 0 || ply >= SEARCH_MAX_PLY - 1)
+    return evaluate(state);
+
+  // Une recherche au moins aussi profonde de cette position peut suffire
+  TTData entry;
+  const bool tt_hit = ctx->tt && tt_probe(ctx->tt, state->hash, &entry);
+  if (tt_hit && entry.depth >= depth) {
+    if (entry.bound == BoundExact)
+      return entry.score;
+    if (entry.bound == BoundLower && entry.score > alpha)
+      alpha = entry.score;
+    else if (entry.bound == BoundUpper && entry.score < beta)
+      beta = entry.score;
+    if (alpha >= beta)
+      return entry.score;
+  }
+
+  Move moves[MAX_MOVES];
+  int scores[MAX_MOVES];
+  const size_t count = generate_moves(state, moves);
+  if (count == 0)
+    return final_score(state);
+
+  score_moves(ctx, moves, scores, count, ply,
+              tt_hit && entry.has_move ? &entry.move : NULL);
+
+  const int alpha_start = alpha;
+  int best = -SCORE_INFINITE;
+  Move best_move = moves[0];
+  for (size_t i = 0; i < count; ++i) {
+    pick_move(moves, scores, count, i);
+
+    UndoRecord undo;
+    make_move(state, moves[i], &undo);
+    const int score = -negamax(ctx, depth - 1, ply + 1, -beta, -alpha);
+    unmake_move(state, &undo);
+
+    if (ctx->stopped)
+      return 0;
+
+    if (score > best) {
+      best = score;
+      best_move = moves[i];
+    }
+    if (score > alpha)
+      alpha = score;
+    if (alpha >= beta) {
+      // Coup « killer » : il a provoqué une coupure à cette profondeur
+      if (!same_move(moves[i], ctx->killers[ply][0])) {
+        ctx->killers[ply][1] = ctx->killers[ply][0];
+        ctx->killers[ply][0] = moves[i];
+      }
+      break;
+    }
+  }
+
+  if (ctx->tt) {
+    const TTBound bound = best >= beta          ? BoundLower
+                          : best > alpha_start ? BoundExact
+                                               : BoundUpper;
+    tt_store(ctx->tt, state->hash,
+             (TTData){.score = best,
+                      .depth = (uint8_t)depth,
+                      .bound = bound,
+                      .has_move = true,
+                      .move = best_move});
+  }
+
+  return best;
+}
+
+// Approfondissement itératif depuis la racine, dans le thread appelant
+static void iterate(SearchContext *ctx, SearchResult *result) {
+  GameState *state = ctx->state;
+  const uint8_t max_depth = ctx->limits.max_depth;
+
+  for (int ply = 0; ply < SEARCH_MAX_PLY; ++ply) {
+    // Coup impossible (type hors bornes) : ne correspond à aucun coup généré
+    ctx->killers[ply][0] = ctx->killers[ply][1] = (Move){.kind = 0xFF};
+  }
+
+  Move moves[MAX_MOVES];
+  int scores[MAX_MOVES];
+  const size_t count = generate_moves(state, moves);
+  if (count == 0 || is_game_over(state))
+    return;
+
+  result->found = true;
+  result->best_move = moves[0];
+
+  for (uint8_t depth = 1 + ctx->depth_offset; depth <= max_depth; ++depth) {
+    const Move *first = result->depth > 0 ? &result->best_move : NULL;
+    TTData entry;
+    if (!first && ctx->tt && tt_probe(ctx->tt, state->hash, &entry) &&
+        entry.has_move)
+      first = &entry.move;
+    score_moves(ctx, moves, scores, count, 0, first);
+
+    int alpha = -SCORE_INFINITE;
+    Move best_move = moves[0];
+
+    for (size_t i = 0; i < count; ++i) {
+      pick_move(moves, scores, count, i);
+
+      UndoRecord undo;
+      make_move(state, moves[i], &undo);
+      const int score = -negamax(ctx, depth - 1, 1, -SCORE_INFINITE, -alpha);
+      unmake_move(state, &undo);
+
+      if (ctx->stopped)
+        break;
+      if (score > alpha) {
+        alpha = score;
+        best_move = moves[i];
+      }
+    }
+
+    // Une itération interrompue n'est pas fiable : on garde la précédente
+    if (ctx->stopped)
+      break;
+
+    result->best_move = best_move;
+    result->score = alpha;
+    result->depth = depth;
+    if (ctx->tt) {
+      tt_store(ctx->tt, state->hash,
+               (TTData){.score = alpha,
+                        .depth = depth,
+                        .bound = BoundExact,
+                        .has_move = true,
+                        .move = best_move});
+    }
+
+    // Inutile d'aller plus loin si le résultat de la partie est connu
+    if (alpha >= SCORE_WIN || alpha <= -SCORE_WIN)
+      break;
+  }
+}
+
+// Thread auxiliaire de la recherche Lazy SMP : il cherche la même position
+// sur sa propre copie de l'état et ne communique que par la table partagée.
+typedef struct {
+  SearchContext ctx;
+  SearchResult result;
+  GameState state;
+  Thread thread;
+  bool running;
+} SearchHelper;
+
+static void run_helper(void *arg) {
+  SearchHelper *helper = arg;
+  iterate(&helper->ctx, &helper->result);
+}
+
+SearchResult search_best_move(GameState *state, SearchLimits limits) {
+  if (limits.max_depth == 0 || limits.max_depth >= SEARCH_MAX_PLY)
+    limits.max_depth = SEARCH_MAX_PLY - 1;
+
+  volatile uint64_t stop_all = 0;
+  SearchContext ctx = {.state = state,
+                       .limits = limits,
+                       .tt = limits.tt,
+                       .stop_all = &stop_all,
+                       .start_ms = now_ms()};
+  SearchResult result = {.found = false};
+
+  // Sans table partagée, les threads auxiliaires ne serviraient à rien
+  const uint32_t helper_count =
+      (limits.threads > 1 && limits.tt) ? limits.threads - 1u : 0;
+  SearchHelper *helpers = NULL;
+  if (helper_count > 0) {
+    helpers = calloc(helper_count, sizeof(SearchHelper));
+    if (helpers == NULL) {
+      perror("Failed to allocate memory for search threads");
+      exit(EXIT_FAILURE);
+    }
+  }
+
+  for (uint32_t i = 0; i < helper_count; ++i) {
+    SearchHelper *helper = &helpers[i];
+    helper->state = clone_game_state(state);
+    helper->ctx = ctx;
+    helper->ctx.state = &helper->state;
+    // Un thread sur deux commence une profondeur plus loin, pour que les
+    // threads n'explorent pas tous le même arbre au même moment
+    helper->ctx.depth_offset = (uint8_t)(i % 2 == 0);
+    helper->running = start_thread(&helper->thread, run_helper, helper);
+  }
+
+  iterate(&ctx, &result);
+  atomic_store_u64(&stop_all, 1);
+
+  result.nodes = ctx.nodes;
+  for (uint32_t i = 0; i < helper_count; ++i) {
+    SearchHelper *helper = &helpers[i];
+    if (helper->running)
+      join_thread(helper->thread);
+    result.nodes += helper->ctx.nodes;
+
+    // Une itération complète plus profonde d'un autre thread est meilleure
+    if (helper->result.found && helper->result.depth > result.depth) {
+      result.best_move = helper->result.best_move;
+      result.score = helper->result.score;
+      result.depth = helper->result.depth;
+    }
+    free_game_state(&helper->state);
+  }
+  free(helpers);
+
+  result.time_ms = now_ms() - ctx.start_ms;
+  return result;
+}
+
+bool play_engine_turn(GameState *state, const SearchLimits limits) {
+  const SearchResult result = search_best_move(state, limits);
+  if (!result.found)
+    return false;
+
+  const Move move = result.best_move;
+  char position[4];
+  format_position(state->board.dim, move.x, move.y, position);
+  printf("L'ordinateur pose %s en %s (profondeur %d, %llu positions).\n",
+         stringify_piece((PieceKind)move.kind), position, result.depth,
+         (unsigned long long)result.nodes);
+
+  place_piece(state, (PieceKind)move.kind, move.x, move.y);
+
+  if (state->mode == Connect && move.kind == King) {
+    printf("Le roi a été placé par le joueur %s. La partie est terminée !\n",
+           stringify_player(state->is_turn_of));
+  }
+  return true;
+}
@@ -0,0 +1,87 @@
+#ifndef SEARCH_H
+#define SEARCH_H
+#include "move.h"
+#include "tt.h"
+
+#define SEARCH_MAX_PLY 64 ///< Profondeur maximale d'une recherche
+#define SCORE_INFINITE 1000000
+#define SCORE_WIN 100000 ///< Score d'une partie terminée et gagnée
+
+/**
+ * @brief Limites et ressources d'une recherche.
+ */
+typedef struct {
+  uint8_t max_depth;      ///< Profondeur maximale, en coups (1 à 64)
+  uint32_t time_limit_ms; ///< Temps de réflexion maximal (0 : illimité)
+  uint32_t threads;       ///< Nombre de threads (0 ou 1 : le thread appelant)
+  TranspositionTable *tt; ///< Table de transposition partagée (NULL : aucune)
+} SearchLimits;
+
+/**
+ * @brief Résultat d'une recherche.
+ */
+typedef struct {
+  bool found;      ///< `false` si le joueur n'a aucun coup légal
+  Move best_move;  ///< Meilleur coup trouvé
+  int score;       ///< Score du coup, du point de vue du joueur actuel
+  uint8_t depth;   ///< Dernière profondeur entièrement explorée
+  uint64_t nodes;  ///< Nombre de positions visitées
+  uint64_t time_ms; ///< Durée de la recherche
+} SearchResult;
+
+/**
+ * @brief Évalue une position du point de vue du joueur dont c'est le tour.
+ *
+ * Évaluation territoriale : les cases occupées capturées (celles que compte
+ * `get_captured_count_of`, et donc le résultat final) valent davantage que les
+ * cases vides capturées, qui peuvent encore changer de propriétaire.
+ *
+ * @param state Pointeur vers l'état de jeu.
+ * @return int Score positif si le joueur actuel est en avance.
+ */
+int evaluate(const GameState *state);
+
+/**
+ * @brief Indique si la partie est terminée dans cette position.
+ *
+ * Même condition que la boucle de jeu : le joueur dont c'est le tour n'a plus
+ * de pièces à poser.
+ *
+ * @param state Pointeur vers l'état de jeu.
+ * @return bool `true` si la partie est terminée.
+ */
+bool is_game_over(const GameState *state);
+
+/**
+ * @brief Cherche le meilleur coup pour le joueur dont c'est le tour.
+ *
+ * Recherche alpha-beta en approfondissement itératif : profondeur 1, 2, ...
+ * jusqu'à `max_depth` ou jusqu'à épuisement du temps. Les coups sont triés
+ * (meilleur coup de l'itération précédente, coups « killer », puis nombre de
+ * cases gagnées). L'état est modifié pendant la recherche avec `make_move` /
+ * `unmake_move` puis rendu tel quel.
+ *
+ * Avec `threads > 1` et une table, la recherche est parallèle (« Lazy SMP ») :
+ * chaque thread auxiliaire cherche la même position sur une copie de l'état,
+ * et les threads ne partagent que la table de transposition. Le coup retenu
+ * est celui de l'itération complète la plus profonde.
+ *
+ * @param state Pointeur vers l'état de jeu.
+ * @param limits Les limites de profondeur et de temps.
+ * @return SearchResult Le meilleur coup trouvé et les statistiques.
+ */
+SearchResult search_best_move(GameState *state, SearchLimits limits);
+
+/**
+ * @brief Fait jouer l'ordinateur pour le joueur dont c'est le tour.
+ *
+ * Cherche un coup avec `search_best_move`, l'annonce puis le pose avec
+ * `place_piece`. Comme `play_conquest_turn`, ne passe pas la main.
+ *
+ * @param state Pointeur vers l'état de jeu.
+ * @param limits Les limites de la recherche.
+ * @return bool `false` si l'ordinateur n'a aucun coup légal.
+ */
+bool play_engine_turn(GameState *state, SearchLimits limits);
+
+#endif // SEARCH_H
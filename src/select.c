@@ -56,9 +56,10 @@ StartOption select_option() {
 
 RoundOption select_round_option() {
   print_text("Choisissez une option:\n\t1. Poser une pièce\n\t2. "
-             "Abandonner\n\t3. Sauvegarder la partie\n");
+             "Abandonner\n\t3. Sauvegarder la partie\n\t4. Redessiner "
+             "l'écran\n");
 
-  const char option = validate('1', '3');
+  const char option = validate('1', '4');
 
   return (RoundOption)(option - '0');
 }
@@ -73,6 +74,25 @@ GameMode select_mode() {
   return (GameMode)(option - '0');
 }
 
+OpponentKind select_opponent() {
+  print_text("Choisissez votre adversaire:\n");
+  print_text("\t1. Un autre joueur\n");
+  print_text("\t2. L'ordinateur (alpha-beta)\n");
+  print_text("\t3. L'ordinateur (Monte Carlo)\n");
+
+  const char option = validate('1', '3');
+
+  return (OpponentKind)(option - '0');
+}
+
+uint32_t select_engine_time() {
+  print_text("Temps de réflexion de l'ordinateur, en secondes (1 à 9).\n");
+
+  const char option = validate('1', '9');
+
+  return (uint32_t)(option - '0') * 1000;
+}
+
 uint8_t select_dimension() {
   print_text("Choisissez les dimensions de l'échiquier entre 6 et 12.\n");
   char buffer[3];
@@ -115,9 +135,7 @@ Tile select_valid_tile(const GameState* state) {
   Tile tile;
   bool piece_allowed = false;
 
-  PieceCountTracker* piece_counter = (state->is_turn_of == User)
-      ? (PieceCountTracker*)&state->piece_counter_1
-      : (PieceCountTracker*)&state->piece_counter_2;
+  const PieceCountTracker* piece_counter = get_user_turn_count_tracker(state);
 
   do {
     printf("Quelle pièce souhaitez-vous jouer ? ");
@@ -129,7 +147,7 @@ Tile select_valid_tile(const GameState* state) {
       continue;
     }
 
-    piece_allowed = add_piece(piece_counter, tile.value.kind);
+    piece_allowed = get_piece_count(piece_counter, tile.value.kind) > 0;
     if (!piece_allowed) {
       printf("Vous n'avez plus de %s à jouer.\n", nom_piece);
     }
@@ -178,7 +196,7 @@ TargetPosition select_valid_target_position(const GameState* state) {
     const uint8_t px = (uint8_t)col;
     const uint8_t py = dim - (uint8_t)row;
 
-    if (state->board.tiles[py][px].some) {
+    if (is_tile_occupied(&state->board, px, py)) {
       printf("Erreur : Il y a déjà une pièce en %s.\n", target_tile);
       continue;
     }
@@ -192,24 +210,7 @@ TargetPosition select_valid_target_position(const GameState* state) {
 //> CONNECT MODE
 // Vérifie si le joueur actuel a au moins une case capturée par le type de pièce requis
 bool has_tile_captured_by_kind_for_current_player(const GameState* state, PieceKind required_kind) {
-  const uint8_t dim = state->board.dim;
-
-  for (uint8_t y = 0; y < dim; y++) {
-    for (uint8_t x = 0; x < dim; x++) {
-      const Tile* tile = &state->board.tiles[y][x];
-
-      // Vérifie si la case est capturée par le joueur actuel
-      if (tile->captured_by.some && tile->captured_by.player == state->is_turn_of) {
-        // Vérifie si cette case a été capturée par le bon type de pièce
-        if (tile->some && tile->value.kind == required_kind &&
-            tile->value.player == state->is_turn_of) {
-          return true;
-        }
-      }
-    }
-  }
-
-  return false;
+  return has_kind_on_captured_tile(state, state->is_turn_of, required_kind);
 }
 
 // Sélection d'une pièce valide pour le mode Connect
@@ -219,9 +220,7 @@ Tile select_valid_tile_for_connect(const GameState* state) {
   Tile tile;
   bool piece_allowed = false;
 
-  PieceCountTracker* piece_counter = (state->is_turn_of == User)
-      ? (PieceCountTracker*)&state->piece_counter_1
-      : (PieceCountTracker*)&state->piece_counter_2;
+  const PieceCountTracker* piece_counter = get_user_turn_count_tracker(state);
 
   while (1) {
     printf("Quelle pièce souhaitez-vous jouer ? ");
@@ -278,7 +277,7 @@ Tile select_valid_tile_for_connect(const GameState* state) {
     }
 
     // Vérifie que le joueur a encore cette pièce disponible
-    piece_allowed = add_piece(piece_counter, kind);
+    piece_allowed = get_piece_count(piece_counter, kind) > 0;
     if (!piece_allowed) {
       printf("Vous n'avez plus de %s à jouer.\n", nom_piece);
       continue;
@@ -290,47 +289,40 @@ Tile select_valid_tile_for_connect(const GameState* state) {
 
 // Vérifie si une position est valide pour le placement en mode Connect
 bool is_valid_connect_placement(const GameState* state, PieceKind kind, uint8_t x, uint8_t y) {
-  const Tile* target_tile = &state->board.tiles[y][x];
+  const BoardPlanes* planes = &state->board.planes;
 
-  switch (kind) {
-    case Pawn:
-      // Les pions peuvent être posés n'importe où (case vide)
-      return !target_tile->some;
+  // Dans tous les cas la case doit être vide
+  if (bb_test(&planes->occupied, x, y))
+    return false;
+
+  // Les pions peuvent être posés n'importe où (case vide)
+  if (kind == Pawn)
+    return true;
 
+  // Les autres pièces ne peuvent être posées que sur une case capturée par le joueur actuel
+  if (!bb_test(&planes->captured_by[state->is_turn_of], x, y))
+    return false;
+
+  switch (kind) {
     case Knight:
       // Les cavaliers ne peuvent être placés que sur des cases capturées par des pions du même joueur
-      return !target_tile->some &&
-             target_tile->captured_by.some &&
-             target_tile->captured_by.player == state->is_turn_of &&
-             is_tile_captured_by_piece_kind(state, x, y, Pawn);
+      return is_tile_captured_by_piece_kind(state, x, y, Pawn);
 
     case Bishop:
       // Les fous ne peuvent être placés que sur des cases capturées par des cavaliers du même joueur
-      return !target_tile->some &&
-             target_tile->captured_by.some &&
-             target_tile->captured_by.player == state->is_turn_of &&
-             is_tile_captured_by_piece_kind(state, x, y, Knight);
+      return is_tile_captured_by_piece_kind(state, x, y, Knight);
 
     case Rook:
       // Les tours ne peuvent être placées que sur des cases capturées par des fous du même joueur
-      return !target_tile->some &&
-             target_tile->captured_by.some &&
-             target_tile->captured_by.player == state->is_turn_of &&
-             is_tile_captured_by_piece_kind(state, x, y, Bishop);
+      return is_tile_captured_by_piece_kind(state, x, y, Bishop);
 
     case Queen:
       // La reine ne peut être placée que sur des cases capturées par des tours du même joueur
-      return !target_tile->some &&
-             target_tile->captured_by.some &&
-             target_tile->captured_by.player == state->is_turn_of &&
-             is_tile_captured_by_piece_kind(state, x, y, Rook);
+      return is_tile_captured_by_piece_kind(state, x, y, Rook);
 
     case King:
       // Le roi ne peut être placé que sur des cases capturées par la reine du même joueur
-      return !target_tile->some &&
-             target_tile->captured_by.some &&
-             target_tile->captured_by.player == state->is_turn_of &&
-             is_tile_captured_by_piece_kind(state, x, y, Queen);
+      return is_tile_captured_by_piece_kind(state, x, y, Queen);
 
     default:
       return false;
@@ -377,7 +369,7 @@ TargetPosition select_valid_target_position_for_connect(const GameState* state,
     const uint8_t px = (uint8_t)col;
     const uint8_t py = dim - (uint8_t)row;
 
-    if (state->board.tiles[py][px].some) {
+    if (is_tile_occupied(&state->board, px, py)) {
       printf("Erreur : Il y a déjà une pièce en %s.\n", target_tile);
       continue;
     }
@@ -8,7 +8,9 @@ typedef uint8_t __uint8_t;
 
 typedef enum { Start = 1, Restart, Leave } StartOption;
 
-typedef enum { Play = 1, GiveUp, SaveGame } RoundOption;
+typedef enum { Play = 1, GiveUp, SaveGame, Redraw } RoundOption;
+
+typedef enum { Human = 1, AlphaBetaEngine, MctsEngine } OpponentKind;
 
 /**
  * @brief Affiche un menu et lit une option utilisateur comprise entre 1 et 3.
@@ -28,16 +30,17 @@ typedef enum { Play = 1, GiveUp, SaveGame } RoundOption;
 StartOption select_option();
 
 /**
- * @brief Affiche un menu et lit une option utilisateur comprise entre 1 et 3.
+ * @brief Affiche un menu et lit une option utilisateur comprise entre 1 et 4.
  *
- * Cette fonction présente un menu interactif à l'utilisateur avec trois options
- * :
+ * Cette fonction présente un menu interactif à l'utilisateur avec quatre
+ * options :
  *   1. Poser une pièce
  *   2. Abandonner
  *   3. Sauvegarder la partie
+ *   4. Redessiner l'écran (s'il a été abîmé, cf. `invalidate_screen`)
  *
  * Elle lit l'entrée de l'utilisateur depuis le terminal,
- * vérifie que la valeur est comprise entre 1 et 3,
+ * vérifie que la valeur est comprise entre 1 et 4,
  * et renvoie ce choix sous forme de l'enum RoundOption.
  *
  * @return RoundOption Le choix de l'utilisateur.
@@ -57,6 +60,26 @@ RoundOption select_round_option();
  * @return GameMode Le mode sélectionné par l'utilisateur.
  */
 GameMode select_mode();
+
+/**
+ * @brief Demande à l'utilisateur de choisir son adversaire.
+ *
+ * Affiche les adversaires disponibles :
+ *   1. Un autre joueur sur le même terminal
+ *   2. L'ordinateur (recherche alpha-beta)
+ *   3. L'ordinateur (recherche arborescente Monte Carlo)
+ *
+ * @return OpponentKind L'adversaire sélectionné.
+ */
+OpponentKind select_opponent();
+
+/**
+ * @brief Demande le temps de réflexion accordé à l'ordinateur.
+ *
+ * @return uint32_t Le temps choisi, en millisecondes (1 à 9 secondes).
+ */
+uint32_t select_engine_time();
+
 /**
  * @brief Demande à l'utilisateur de choisir la taille de l'échiquier.
  *
@@ -0,0 +1,277 @@
+#include "selfplay.h"
+#include "game_record.h"
+#include "movegen.h"
+#include "pool.h"
+#include "save.h"
+#include "stream_writer.h"
+#include "timer.h"
+#include <stdarg.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define SELFPLAY_MAX_PLIES 64 ///< Une partie dure au plus 16 poses par joueur
+#define SELFPLAY_QUEUE_SIZE 4096
+#define SELFPLAY_REPORT_MS 1000
+
+// Texte d'une partie, construit par le thread qui l'a jouée
+typedef struct {
+  char *data;
+  size_t length;
+  size_t capacity;
+} TextBuffer;
+
+typedef struct {
+  const SelfplayOptions *options;
+  Engine *engines; // Un moteur par thread
+  StreamWriter writer;
+  volatile uint64_t games_done;
+  volatile uint64_t positions_done;
+  volatile uint64_t finished; // Toutes les parties sont jouées
+} SelfplayContext;
+
+// Garantit au moins `extra` octets libres à la fin du texte
+static void reserve_text(TextBuffer *text, const size_t extra) {
+  if (text->capacity - text->length >= extra)
+    return;
+
+  while (text->capacity - text->length < extra)
+    text->capacity *= 2;
+  text->data = realloc(text->data, text->capacity);
+  if (text->data == NULL) {
+    perror("Failed to allocate memory for a game record");
+    exit(EXIT_FAILURE);
+  }
+}
+
+static void append_text(TextBuffer *text, const char *format, ...) {
+  for (;;) {
+    va_list args;
+    va_start(args, format);
+    const int written = vsnprintf(text->data + text->length,
+                                  text->capacity - text->length, format, args);
+    va_end(args);
+
+    if (written >= 0 && (size_t)written < text->capacity - text->length) {
+      text->length += (size_t)written;
+      return;
+    }
+
+    text->capacity *= 2;
+    text->data = realloc(text->data, text->capacity);
+    if (text->data == NULL) {
+      perror("Failed to allocate memory for a game record");
+      exit(EXIT_FAILURE);
+    }
+  }
+}
+
+static const char *stringify_mode(const GameMode mode) {
+  return mode == Conquest ? "Conquest" : "Connect";
+}
+
+// Résultat selon `compare_scores`, du point de vue de `player`
+static const char *outcome_for(const int user_score, const Player player) {
+  const int score = player == User ? user_score : -user_score;
+  return score > 0 ? "1" : score < 0 ? "0" : "0.5";
+}
+
+// Ligne `game` : conditions de départ, résultat, coups à la suite
+static void append_game_line(TextBuffer *text, const uint32_t index,
+                             const GameMode mode, const uint8_t dim,
+                             const Player first, const GameState *state,
+                             const Move *moves, const int plies,
+                             const int user_score) {
+  append_text(text,
+              "game %u mode=%s dim=%u first=%s result=%s occupied=%u,%u "
+              "empty=%u,%u plies=%d moves=",
+              index, stringify_mode(mode), dim, stringify_player(first),
+              user_score > 0   ? "User"
+              : user_score < 0 ? "Opponent"
+                               : "Draw",
+              state->owned_occupied[User], state->owned_occupied[Opponent],
+              state->owned_empty[User], state->owned_empty[Opponent], plies);
+  for (int ply = 0; ply < plies; ++ply) {
+    char position[4];
+    format_position(dim, moves[ply].x, moves[ply].y, position);
+    append_text(text, "%s%s:%s", ply > 0 ? "," : "",
+                stringify_piece((PieceKind)moves[ply].kind), position);
+  }
+  append_text(text, "\n");
+}
+
+// Rejoue la partie pour écrire chaque position, une fois le résultat connu
+static void append_positions(TextBuffer *text, const uint32_t index,
+                             const GameMode mode, const uint8_t dim,
+                             const Player first, const Move *moves,
+                             const int plies, const int user_score) {
+  GameState state = init_game_state_with(mode, dim, first);
+
+  for (int ply = 0; ply < plies; ++ply) {
+    append_text(text, "position %u %d %s ", index, ply,
+                outcome_for(user_score, state.is_turn_of));
+
+    // La position est écrite directement à la suite du texte de la partie
+    reserve_text(text, SERIALIZE_MAX_SIZE + 1);
+    char *position = text->data + text->length;
+    const size_t length = serialize_to_buffer(&state, position,
+                                              text->capacity - text->length);
+    for (size_t i = 0; i + 1 < length; ++i) {
+      if (position[i] == '\n')
+        position[i] = ' ';
+    }
+    text->length += length;
+
+    UndoRecord undo;
+    make_move(&state, moves[ply], &undo);
+  }
+  free_game_state(&state);
+}
+
+static void play_game(void *arg, const uint32_t worker, const uint32_t index) {
+  SelfplayContext *context = arg;
+  const SelfplayOptions *options = context->options;
+  Engine *engine = &context->engines[worker];
+
+  // La partie ne dépend que de la graine de la série et de son numéro
+  Rng rng = init_rng(options->seed ^ (0x9E3779B97F4A7C15ULL * (index + 1)));
+  GameMode mode = options->mode;
+  if (mode == 0)
+    mode = rng_below(&rng, 2) ? Connect : Conquest;
+  const uint8_t dim = (uint8_t)(6 + rng_below(&rng, 7));
+  const Player first = rng_below(&rng, 2) ? Opponent : User;
+
+  GameState state = init_game_state_with(mode, dim, first);
+  reset_engine(engine, rng_next(&rng));
+
+  Move moves[SELFPLAY_MAX_PLIES];
+  uint32_t times_ms[SELFPLAY_MAX_PLIES];
+  int plies = 0;
+  while (plies < SELFPLAY_MAX_PLIES && !is_game_over(&state)) {
+    Move move;
+    const uint64_t start_ms = now_ms();
+    const bool found = (uint32_t)plies < options->random_plies
+                           ? pick_random_move(&state, &rng, &move)
+                           : engine_choose_move(engine, &state, &move);
+    if (!found)
+      break;
+    times_ms[plies] = (uint32_t)(now_ms() - start_ms);
+
+    UndoRecord undo;
+    make_move(&state, move, &undo);
+    moves[plies++] = move;
+  }
+
+  const int user_score = compare_scores(&state, User);
+  TextBuffer text = {.data = malloc(1024), .capacity = 1024};
+  if (text.data == NULL) {
+    perror("Failed to allocate memory for a game record");
+    exit(EXIT_FAILURE);
+  }
+
+  if (options->records) {
+    // Partie au format de game_record.h, suivie d'une ligne vide
+    const GameRecord record = {.mode = mode,
+                               .dim = dim,
+                               .white = first,
+                               .result = result_of_game(&state, first),
+                               .moves = moves,
+                               .times_ms = times_ms,
+                               .count = (uint32_t)plies};
+    const size_t size = format_game_record(&record, NULL, 0);
+    reserve_text(&text, size + 2);
+    format_game_record(&record, text.data + text.length, size + 1);
+    text.length += size;
+    append_text(&text, "\n");
+  } else {
+    append_game_line(&text, index, mode, dim, first, &state, moves, plies,
+                     user_score);
+  }
+
+  if (options->positions)
+    append_positions(&text, index, mode, dim, first, moves, plies, user_score);
+
+  free_game_state(&state);
+  stream_write(&context->writer, text.data, text.length);
+
+  atomic_add_u64(&context->positions_done, (uint64_t)plies);
+  atomic_add_u64(&context->games_done, 1);
+}
+
+static void run_games(void *arg) {
+  SelfplayContext *context = arg;
+  parallel_for(context->options->threads, context->options->games, play_game,
+               context);
+  atomic_store_release_u64(&context->finished, 1);
+}
+
+static void report_progress(const SelfplayContext *context,
+                            const uint64_t elapsed_ms) {
+  const uint64_t games = atomic_load_u64(&context->games_done);
+  const uint64_t positions = atomic_load_u64(&context->positions_done);
+  const double seconds = elapsed_ms > 0 ? (double)elapsed_ms / 1000.0 : 1.0;
+
+  fprintf(stderr,
+          "\r%llu/%u parties, %.1f parties/s, %.0f positions/s, %.1f Mo "
+          "écrits",
+          (unsigned long long)games, context->options->games,
+          (double)games / seconds, (double)positions / seconds,
+          (double)atomic_load_u64(&context->writer.written) / 1e6);
+}
+
+int run_selfplay(const SelfplayOptions *options) {
+  SelfplayContext context = {.options = options};
+  const uint32_t threads = options->threads > 0 ? options->threads : 1;
+
+  if (!open_stream_writer(&context.writer, options->output,
+                          SELFPLAY_QUEUE_SIZE)) {
+    perror("Impossible d'ouvrir le fichier de sortie");
+    return 1;
+  }
+
+  context.engines = malloc(threads * sizeof(Engine));
+  if (context.engines == NULL) {
+    perror("Failed to allocate memory for the engines");
+    exit(EXIT_FAILURE);
+  }
+  for (uint32_t i = 0; i < threads; ++i)
+    context.engines[i] = init_engine(options->engine, options->seed + i);
+
+  char description[128];
+  format_engine_config(&options->engine, description, sizeof(description));
+  fprintf(stderr, "%u parties, %u threads, moteur %s, graine %llu\n",
+          options->games, threads, description,
+          (unsigned long long)options->seed);
+
+  // Les parties sont jouées par un autre thread : celui-ci affiche la
+  // progression
+  const uint64_t start_ms = now_ms();
+  Thread games_thread;
+  if (!start_thread(&games_thread, run_games, &context)) {
+    perror("Impossible de créer le thread des parties");
+    return 1;
+  }
+  uint64_t next_report_ms = SELFPLAY_REPORT_MS;
+  while (!atomic_load_acquire_u64(&context.finished)) {
+    sleep_thread_ms(50);
+    const uint64_t elapsed_ms = now_ms() - start_ms;
+    if (elapsed_ms >= next_report_ms) {
+      report_progress(&context, elapsed_ms);
+      next_report_ms += SELFPLAY_REPORT_MS;
+    }
+  }
+  join_thread(games_thread);
+
+  const bool written = close_stream_writer(&context.writer);
+  report_progress(&context, now_ms() - start_ms);
+  fprintf(stderr, "\n");
+
+  for (uint32_t i = 0; i < threads; ++i)
+    free_engine(&context.engines[i]);
+  free(context.engines);
+
+  if (!written) {
+    fprintf(stderr, "Erreur lors de l'écriture de %s\n", options->output);
+    return 1;
+  }
+  return 0;
+}
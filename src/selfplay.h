@@ -0,0 +1,49 @@
+#ifndef SELFPLAY_H
+#define SELFPLAY_H
+#include "engine.h"
+
+/**
+ * @brief Réglages d'une série de parties automatiques.
+ */
+typedef struct {
+  uint32_t games;        ///< Nombre de parties
+  uint32_t threads;      ///< Parties jouées en même temps
+  uint64_t seed;         ///< Graine de la série
+  GameMode mode;         ///< Mode imposé (0 : tiré au hasard à chaque partie)
+  EngineConfig engine;   ///< Moteur des deux joueurs
+  uint32_t random_plies; ///< Premiers coups joués au hasard (ouvertures)
+  const char *output;    ///< Fichier de sortie
+  bool positions;        ///< Écrire aussi chaque position jouée
+  bool records;          ///< Écrire les parties au format de `game_record.h`
+} SelfplayOptions;
+
+/**
+ * @brief Fait jouer le moteur contre lui-même et écrit les parties sur disque.
+ *
+ * Les parties sont réparties par `parallel_for` (un moteur par thread, la
+ * recherche elle-même reste sur un thread par défaut). La partie n° i ne
+ * dépend que de la graine et de i : mode (si non imposé), dimension (6 à 12),
+ * premier joueur et coups d'ouverture sont tirés d'un générateur initialisé
+ * avec ces deux valeurs. Avec un moteur sans limite de temps, la série est
+ * donc reproductible quel que soit le nombre de threads ; seul l'ordre des
+ * lignes du fichier change.
+ *
+ * Chaque partie donne une ligne :
+ * `game <n> mode=<mode> dim=<d> first=<joueur> result=<User|Opponent|Draw>
+ * occupied=<u>,<o> empty=<u>,<o> plies=<k> moves=<pièce>:<case>,...`
+ * ou, avec `records`, la partie au format de `format_game_record` (temps de
+ * chaque coup compris) suivie d'une ligne vide, et, avec `positions`, une
+ * ligne par position avant chaque coup :
+ * `position <n> <coup> <résultat pour le joueur au trait : 1, 0.5 ou 0>
+ * <position au format de la commande position du protocole>`.
+ *
+ * Les lignes sont confiées à un `StreamWriter` : les threads de jeu
+ * n'attendent pas le disque. Parties et positions par seconde sont affichées
+ * sur la sortie d'erreur pendant la série.
+ *
+ * @param options Les réglages de la série.
+ * @return int Code de sortie du programme.
+ */
+int run_selfplay(const SelfplayOptions *options);
+
+#endif // SELFPLAY_H
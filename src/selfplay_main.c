@@ -0,0 +1,84 @@
+#include "attack.h"
+#include "selfplay.h"
+#include "thread.h"
+#include "zobrist.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static void print_usage(const char *program) {
+  fprintf(stderr,
+          "Usage : %s [--games N] [--threads N] [--seed S]\n"
+          "          [--mode conquest|connect] [--engine SPEC]\n"
+          "          [--random-plies N] [--out FICHIER]\n"
+          "          [--positions | --records]\n"
+          "SPEC : alphabeta[:depth=D] ou mcts[:playouts=P], cf. engine.h\n",
+          program);
+}
+
+static bool parse_arguments(const int argc, char **argv,
+                            SelfplayOptions *options) {
+  *options = (SelfplayOptions){.games = 1000,
+                               .threads = hardware_thread_count(),
+                               .seed = 1,
+                               .random_plies = 2,
+                               .output = "selfplay.txt"};
+  parse_engine_config("alphabeta:depth=2", &options->engine);
+
+  for (int i = 1; i < argc; ++i) {
+    const char *name = argv[i];
+    if (strcmp(name, "--positions") == 0) {
+      options->positions = true;
+      continue;
+    }
+    if (strcmp(name, "--records") == 0) {
+      options->records = true;
+      continue;
+    }
+    if (i + 1 >= argc)
+      return false;
+
+    const char *value = argv[++i];
+    if (strcmp(name, "--games") == 0) {
+      options->games = (uint32_t)strtoul(value, NULL, 10);
+    } else if (strcmp(name, "--threads") == 0) {
+      options->threads = (uint32_t)strtoul(value, NULL, 10);
+      if (options->threads == 0)
+        return false;
+    } else if (strcmp(name, "--seed") == 0) {
+      options->seed = strtoull(value, NULL, 10);
+    } else if (strcmp(name, "--mode") == 0) {
+      if (strcmp(value, "conquest") == 0)
+        options->mode = Conquest;
+      else if (strcmp(value, "connect") == 0)
+        options->mode = Connect;
+      else
+        return false;
+    } else if (strcmp(name, "--engine") == 0) {
+      if (!parse_engine_config(value, &options->engine))
+        return false;
+    } else if (strcmp(name, "--random-plies") == 0) {
+      options->random_plies = (uint32_t)strtoul(value, NULL, 10);
+    } else if (strcmp(name, "--out") == 0) {
+      options->output = value;
+    } else {
+      return false;
+    }
+  }
+  // Les lignes `position` ne se lisent pas comme des parties
+  return !(options->positions && options->records);
+}
+
+int main(const int argc, char **argv) {
+  SelfplayOptions options;
+  if (!parse_arguments(argc, argv, &options)) {
+    print_usage(argv[0]);
+    return 1;
+  }
+
+  // Tables partagées : calculées avant de lancer les threads
+  init_attack_tables();
+  init_zobrist_keys();
+
+  return run_selfplay(&options);
+}
@@ -0,0 +1,111 @@
+#include "stream_writer.h"
+#include <stdlib.h>
+
+#define STREAM_BUFFER_SIZE (1 << 20) ///< Tampon de `FILE`, pour écrire par gros blocs
+
+// File bornée à plusieurs producteurs (algorithme de D. Vyukov) : la case i
+// est libre pour le dépôt n° p quand sa séquence vaut p, et prête à être
+// retirée quand elle vaut p + 1.
+static bool try_dequeue(StreamWriter *writer, char **data, size_t *length) {
+  StreamSlot *slot = &writer->slots[writer->dequeue_pos & writer->mask];
+  if (atomic_load_acquire_u64(&slot->sequence) != writer->dequeue_pos + 1)
+    return false;
+
+  *data = slot->data;
+  *length = slot->length;
+  atomic_store_release_u64(&slot->sequence,
+                           writer->dequeue_pos + writer->mask + 1);
+  writer->dequeue_pos++;
+  return true;
+}
+
+static void run_stream_writer(void *arg) {
+  StreamWriter *writer = arg;
+  char *data;
+  size_t length;
+
+  for (;;) {
+    // `closing` est lu avant la file : s'il était levé et que la file est
+    // vide, plus aucun bloc ne peut arriver
+    const bool closing = atomic_load_acquire_u64(&writer->closing) != 0;
+
+    if (try_dequeue(writer, &data, &length)) {
+      if (fwrite(data, 1, length, writer->file) != length)
+        writer->failed = true;
+      atomic_add_u64(&writer->written, length);
+      free(data);
+    } else if (closing) {
+      break;
+    } else {
+      fflush(writer->file);
+      sleep_thread_ms(1);
+    }
+  }
+}
+
+bool open_stream_writer(StreamWriter *writer, const char *path,
+                        const uint32_t capacity) {
+  uint64_t size = 1;
+  while (size < capacity)
+    size <<= 1;
+
+  *writer = (StreamWriter){.mask = size - 1};
+  writer->file = fopen(path, "wb");
+  if (writer->file == NULL)
+    return false;
+  setvbuf(writer->file, NULL, _IOFBF, STREAM_BUFFER_SIZE);
+
+  writer->slots = calloc(size, sizeof(StreamSlot));
+  if (writer->slots == NULL) {
+    fclose(writer->file);
+    return false;
+  }
+  for (uint64_t i = 0; i < size; ++i)
+    writer->slots[i].sequence = i;
+
+  if (!start_thread(&writer->thread, run_stream_writer, writer)) {
+    free(writer->slots);
+    fclose(writer->file);
+    return false;
+  }
+  return true;
+}
+
+void stream_write(StreamWriter *writer, char *data, const size_t length) {
+  uint64_t pos = atomic_load_u64(&writer->enqueue_pos);
+
+  for (;;) {
+    StreamSlot *slot = &writer->slots[pos & writer->mask];
+    const uint64_t sequence = atomic_load_acquire_u64(&slot->sequence);
+    const int64_t diff = (int64_t)(sequence - pos);
+
+    if (diff == 0) {
+      if (atomic_cas_u64(&writer->enqueue_pos, &pos, pos + 1)) {
+        slot->data = data;
+        slot->length = length;
+        atomic_store_release_u64(&slot->sequence, pos + 1);
+        return;
+      }
+      // `pos` a été mis à jour par l'échec du compare-and-swap
+    } else if (diff < 0) {
+      // File pleine : le thread d'écriture est en retard
+      sleep_thread_ms(1);
+      pos = atomic_load_u64(&writer->enqueue_pos);
+    } else {
+      pos = atomic_load_u64(&writer->enqueue_pos);
+    }
+  }
+}
+
+bool close_stream_writer(StreamWriter *writer) {
+  atomic_store_release_u64(&writer->closing, 1);
+  join_thread(writer->thread);
+
+  // Fermé même après un échec, pour libérer le tampon de `setvbuf`
+  const bool closed = fclose(writer->file) == 0;
+  const bool failed = writer->failed || !closed;
+  free(writer->slots);
+  writer->slots = NULL;
+  writer->file = NULL;
+  return !failed;
+}
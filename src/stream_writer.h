@@ -0,0 +1,71 @@
+#ifndef STREAM_WRITER_H
+#define STREAM_WRITER_H
+#include "thread.h"
+#include <stddef.h>
+#include <stdio.h>
+
+/**
+ * @brief Case de la file d'un `StreamWriter`.
+ */
+typedef struct {
+  volatile uint64_t sequence; ///< Numéro de passage (cf. `stream_write`)
+  char *data;                 ///< Texte à écrire, libéré après écriture
+  size_t length;              ///< Longueur du texte
+} StreamSlot;
+
+/**
+ * @brief Écriture d'un fichier depuis plusieurs threads, par un thread dédié.
+ *
+ * Les threads producteurs déposent des blocs de texte dans une file circulaire
+ * bornée, sans verrou (chaque case porte un numéro de séquence) ; un thread
+ * d'écriture les vide dans le fichier dans l'ordre de dépôt. Un producteur
+ * n'attend que si la file est pleine, c'est-à-dire si le disque ne suit pas.
+ */
+typedef struct {
+  FILE *file;
+  StreamSlot *slots;
+  uint64_t mask;                 ///< Nombre de cases moins un
+  volatile uint64_t enqueue_pos; ///< Prochain dépôt (producteurs)
+  uint64_t dequeue_pos;          ///< Prochain retrait (thread d'écriture)
+  volatile uint64_t closing;     ///< Plus aucun dépôt : vider puis s'arrêter
+  volatile uint64_t written;     ///< Octets écrits
+  bool failed;                   ///< Une écriture a échoué
+  Thread thread;
+} StreamWriter;
+
+/**
+ * @brief Ouvre (en écrasant) un fichier et démarre son thread d'écriture.
+ *
+ * @param writer Le `StreamWriter` à initialiser.
+ * @param path Chemin du fichier.
+ * @param capacity Nombre de blocs en attente au maximum (arrondi à la
+ * puissance de deux supérieure).
+ * @return bool `false` si le fichier ou le thread n'ont pas pu être créés.
+ */
+bool open_stream_writer(StreamWriter *writer, const char *path,
+                        uint32_t capacity);
+
+/**
+ * @brief Dépose un bloc de texte à écrire.
+ *
+ * Peut être appelé par plusieurs threads en même temps. Le `StreamWriter`
+ * devient propriétaire de `data` (alloué avec `malloc`) et le libère une fois
+ * écrit.
+ *
+ * @param writer Le `StreamWriter`.
+ * @param data Le texte.
+ * @param length Sa longueur, en octets.
+ */
+void stream_write(StreamWriter *writer, char *data, size_t length);
+
+/**
+ * @brief Écrit les blocs restants, arrête le thread et ferme le fichier.
+ *
+ * Aucun `stream_write` ne doit être en cours.
+ *
+ * @param writer Le `StreamWriter`.
+ * @return bool `false` si une écriture a échoué.
+ */
+bool close_stream_writer(StreamWriter *writer);
+
+#endif // STREAM_WRITER_H
@@ -0,0 +1,72 @@
+#include "thread.h"
+#include <stdlib.h>
+
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+
+// Les signatures attendues par pthreads et Win32 diffèrent : la fonction et
+// son argument sont transmis au thread dans une petite structure.
+typedef struct {
+  ThreadFunction function;
+  void *arg;
+} ThreadStart;
+
+#ifdef _WIN32
+static DWORD WINAPI thread_entry(LPVOID param) {
+#else
+static void *thread_entry(void *param) {
+#endif
+  const ThreadStart start = *(ThreadStart *)param;
+  free(param);
+  start.function(start.arg);
+  return 0;
+}
+
+bool start_thread(Thread *thread, const ThreadFunction function, void *arg) {
+  ThreadStart *start = malloc(sizeof(ThreadStart));
+  if (start == NULL)
+    return false;
+  start->function = function;
+  start->arg = arg;
+
+#ifdef _WIN32
+  *thread = CreateThread(NULL, 0, thread_entry, start, 0, NULL);
+  if (*thread == NULL) {
+#else
+  if (pthread_create(thread, NULL, thread_entry, start) != 0) {
+#endif
+    free(start);
+    return false;
+  }
+  return true;
+}
+
+void join_thread(const Thread thread) {
+#ifdef _WIN32
+  WaitForSingleObject(thread, INFINITE);
+  CloseHandle(thread);
+#else
+  pthread_join(thread, NULL);
+#endif
+}
+
+void sleep_thread_ms(const uint32_t ms) {
+#ifdef _WIN32
+  Sleep(ms);
+#else
+  usleep((useconds_t)ms * 1000);
+#endif
+}
+
+uint32_t hardware_thread_count(void) {
+#ifdef _WIN32
+  SYSTEM_INFO info;
+  GetSystemInfo(&info);
+  return info.dwNumberOfProcessors > 0 ? (uint32_t)info.dwNumberOfProcessors
+                                       : 1;
+#else
+  const long count = sysconf(_SC_NPROCESSORS_ONLN);
+  return count > 0 ? (uint32_t)count : 1;
+#endif
+}
@@ -0,0 +1,159 @@
+#ifndef THREAD_H
+#define THREAD_H
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef _WIN32
+#include <windows.h>
+typedef HANDLE Thread;
+#else
+#include <pthread.h>
+typedef pthread_t Thread;
+#endif
+
+/// Fonction exécutée par un thread.
+typedef void (*ThreadFunction)(void *arg);
+
+/**
+ * @brief Lance `function(arg)` dans un nouveau thread.
+ *
+ * @param thread Reçoit le thread créé, à passer à `join_thread`.
+ * @param function La fonction à exécuter.
+ * @param arg L'argument transmis à la fonction.
+ * @return bool `false` si le thread n'a pas pu être créé.
+ */
+bool start_thread(Thread *thread, ThreadFunction function, void *arg);
+
+/**
+ * @brief Attend la fin d'un thread lancé par `start_thread`.
+ *
+ * @param thread Le thread à attendre.
+ */
+void join_thread(Thread thread);
+
+/**
+ * @brief Suspend le thread appelant pendant au moins `ms` millisecondes.
+ *
+ * @param ms La durée de la pause.
+ */
+void sleep_thread_ms(uint32_t ms);
+
+/**
+ * @brief Renvoie le nombre de processeurs logiques de la machine.
+ *
+ * @return uint32_t Le nombre de processeurs (au moins 1).
+ */
+uint32_t hardware_thread_count(void);
+
+/*
+ * Accès atomiques à des mots de 32 et 64 bits, sans ordre mémoire imposé :
+ * suffisant pour des compteurs et des drapeaux d'arrêt, et pour les entrées de
+ * table vérifiées par XOR (cf. `tt.h`). Les variantes `acquire` / `release`
+ * servent à publier une donnée initialisée par un autre thread.
+ */
+#if defined(_MSC_VER)
+// Sous MSVC, les accès `volatile` ont déjà la sémantique acquire / release
+static inline uint32_t atomic_load_u32(const volatile uint32_t *p) {
+  return *p;
+}
+static inline uint32_t atomic_load_acquire_u32(const volatile uint32_t *p) {
+  return *p;
+}
+static inline void atomic_store_release_u32(volatile uint32_t *p,
+                                            const uint32_t v) {
+  *p = v;
+}
+static inline uint32_t atomic_add_u32(volatile uint32_t *p, const uint32_t v) {
+  return (uint32_t)InterlockedExchangeAdd((volatile LONG *)p, (LONG)v);
+}
+static inline uint32_t atomic_exchange_u32(volatile uint32_t *p,
+                                           const uint32_t v) {
+  return (uint32_t)InterlockedExchange((volatile LONG *)p, (LONG)v);
+}
+/// Comme `atomic_cas_u64`, sur 32 bits.
+static inline bool atomic_cas_u32(volatile uint32_t *p, uint32_t *expected,
+                                  const uint32_t desired) {
+  const uint32_t seen = (uint32_t)InterlockedCompareExchange(
+      (volatile LONG *)p, (LONG)desired, (LONG)*expected);
+  if (seen == *expected)
+    return true;
+  *expected = seen;
+  return false;
+}
+static inline uint64_t atomic_load_u64(const volatile uint64_t *p) {
+  return *p; // lecture alignée de 64 bits : atomique sur x64
+}
+static inline void atomic_store_u64(volatile uint64_t *p, const uint64_t v) {
+  *p = v;
+}
+static inline uint64_t atomic_add_u64(volatile uint64_t *p, const uint64_t v) {
+  return (uint64_t)InterlockedExchangeAdd64((volatile LONG64 *)p, (LONG64)v);
+}
+static inline uint64_t atomic_load_acquire_u64(const volatile uint64_t *p) {
+  return *p;
+}
+static inline void atomic_store_release_u64(volatile uint64_t *p,
+                                            const uint64_t v) {
+  *p = v;
+}
+/// Remplace `*p` par `desired` s'il vaut `*expected` ; sinon, met à jour
+/// `*expected` avec la valeur lue.
+static inline bool atomic_cas_u64(volatile uint64_t *p, uint64_t *expected,
+                                  const uint64_t desired) {
+  const uint64_t seen = (uint64_t)InterlockedCompareExchange64(
+      (volatile LONG64 *)p, (LONG64)desired, (LONG64)*expected);
+  if (seen == *expected)
+    return true;
+  *expected = seen;
+  return false;
+}
+#else
+static inline uint32_t atomic_load_u32(const volatile uint32_t *p) {
+  return __atomic_load_n(p, __ATOMIC_RELAXED);
+}
+static inline uint32_t atomic_load_acquire_u32(const volatile uint32_t *p) {
+  return __atomic_load_n(p, __ATOMIC_ACQUIRE);
+}
+static inline void atomic_store_release_u32(volatile uint32_t *p,
+                                            const uint32_t v) {
+  __atomic_store_n(p, v, __ATOMIC_RELEASE);
+}
+static inline uint32_t atomic_add_u32(volatile uint32_t *p, const uint32_t v) {
+  return __atomic_fetch_add(p, v, __ATOMIC_RELAXED);
+}
+static inline uint32_t atomic_exchange_u32(volatile uint32_t *p,
+                                           const uint32_t v) {
+  return __atomic_exchange_n(p, v, __ATOMIC_ACQ_REL);
+}
+/// Comme `atomic_cas_u64`, sur 32 bits.
+static inline bool atomic_cas_u32(volatile uint32_t *p, uint32_t *expected,
+                                  const uint32_t desired) {
+  return __atomic_compare_exchange_n(p, expected, desired, false,
+                                     __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE);
+}
+static inline uint64_t atomic_load_u64(const volatile uint64_t *p) {
+  return __atomic_load_n(p, __ATOMIC_RELAXED);
+}
+static inline void atomic_store_u64(volatile uint64_t *p, const uint64_t v) {
+  __atomic_store_n(p, v, __ATOMIC_RELAXED);
+}
+static inline uint64_t atomic_add_u64(volatile uint64_t *p, const uint64_t v) {
+  return __atomic_fetch_add(p, v, __ATOMIC_RELAXED);
+}
+static inline uint64_t atomic_load_acquire_u64(const volatile uint64_t *p) {
+  return __atomic_load_n(p, __ATOMIC_ACQUIRE);
+}
+static inline void atomic_store_release_u64(volatile uint64_t *p,
+                                            const uint64_t v) {
+  __atomic_store_n(p, v, __ATOMIC_RELEASE);
+}
+/// Remplace `*p` par `desired` s'il vaut `*expected` ; sinon, met à jour
+/// `*expected` avec la valeur lue.
+static inline bool atomic_cas_u64(volatile uint64_t *p, uint64_t *expected,
+                                  const uint64_t desired) {
+  return __atomic_compare_exchange_n(p, expected, desired, false,
+                                     __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE);
+}
+#endif
+
+#endif // THREAD_H
@@ -0,0 +1,15 @@
+#include "timer.h"
+
+#ifdef _WIN32
+#include <windows.h>
+
+uint64_t now_ms(void) { return (uint64_t)GetTickCount64(); }
+#else
+#include <time.h>
+
+uint64_t now_ms(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000 + (uint64_t)ts.tv_nsec / 1000000;
+}
+#endif
@@ -0,0 +1,15 @@
+#ifndef TIMER_H
+#define TIMER_H
+#include <stdint.h>
+
+/**
+ * @brief Renvoie le temps écoulé en millisecondes sur une horloge monotone.
+ *
+ * L'origine est arbitraire : seule la différence entre deux appels a un sens.
+ * Contrairement à `clock()`, il s'agit du temps réel et non du temps processeur.
+ *
+ * @return uint64_t Le nombre de millisecondes écoulées.
+ */
+uint64_t now_ms(void);
+
+#endif // TIMER_H
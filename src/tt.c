@@ -0,0 +1,88 @@
+#include "tt.h"
+#include "thread.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Disposition de `TTEntry.data` :
+// bits 0-31 score, 32-39 profondeur, 40-41 borne, 42-44 type de pièce
+// (7 : aucun coup), 45-52 case (y * 12 + x).
+#define TT_NO_MOVE 7
+
+static uint64_t pack_entry(const TTData entry) {
+  const uint64_t kind = entry.has_move ? entry.move.kind : TT_NO_MOVE;
+  const uint64_t square =
+      entry.has_move ? (uint64_t)(entry.move.y * BITBOARD_MAX_DIM + entry.move.x)
+                     : 0;
+
+  return (uint64_t)(uint32_t)entry.score | (uint64_t)entry.depth << 32 |
+         (uint64_t)entry.bound << 40 | kind << 42 | square << 45;
+}
+
+static TTData unpack_entry(const uint64_t data) {
+  TTData entry;
+  entry.score = (int)(int32_t)(uint32_t)data;
+  entry.depth = (uint8_t)(data >> 32);
+  entry.bound = (TTBound)((data >> 40) & 3);
+
+  const uint8_t kind = (uint8_t)((data >> 42) & 7);
+  const uint8_t square = (uint8_t)(data >> 45);
+  entry.has_move = kind != TT_NO_MOVE;
+  entry.move = (Move){.kind = kind,
+                      .x = square % BITBOARD_MAX_DIM,
+                      .y = square / BITBOARD_MAX_DIM};
+  return entry;
+}
+
+TranspositionTable init_tt(const size_t megabytes) {
+  const size_t bytes = (megabytes > 0 ? megabytes : 1) << 20;
+  uint64_t count = 1;
+  while ((count << 1) * sizeof(TTEntry) <= bytes)
+    count <<= 1;
+
+  TranspositionTable tt = {.mask = count - 1};
+  tt.entries = calloc(count, sizeof(TTEntry));
+  if (tt.entries == NULL) {
+    perror("Failed to allocate memory for the transposition table");
+    exit(EXIT_FAILURE);
+  }
+  return tt;
+}
+
+void free_tt(TranspositionTable *tt) {
+  free(tt->entries);
+  tt->entries = NULL;
+  tt->mask = 0;
+}
+
+void clear_tt(TranspositionTable *tt) {
+  memset(tt->entries, 0, (tt->mask + 1) * sizeof(TTEntry));
+}
+
+bool tt_probe(const TranspositionTable *tt, const uint64_t key, TTData *out) {
+  TTEntry *slot = &tt->entries[key & tt->mask];
+  const uint64_t data = atomic_load_u64(&slot->data);
+  const uint64_t check = atomic_load_u64(&slot->check);
+
+  // Entrée vide, autre position ou écritures concurrentes mélangées
+  if ((check ^ data) != key || data == 0)
+    return false;
+
+  *out = unpack_entry(data);
+  return true;
+}
+
+void tt_store(TranspositionTable *tt, const uint64_t key, const TTData entry) {
+  TTEntry *slot = &tt->entries[key & tt->mask];
+  const uint64_t old_data = atomic_load_u64(&slot->data);
+  const uint64_t old_check = atomic_load_u64(&slot->check);
+
+  // Ne pas écraser une recherche plus profonde de la même position
+  if ((old_check ^ old_data) == key && old_data != 0 &&
+      ((old_data >> 32) & 0xFF) > entry.depth)
+    return;
+
+  const uint64_t data = pack_entry(entry);
+  atomic_store_u64(&slot->data, data);
+  atomic_store_u64(&slot->check, key ^ data);
+}
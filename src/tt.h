@@ -0,0 +1,96 @@
+#ifndef TT_H
+#define TT_H
+#include "move.h"
+#include <stddef.h>
+
+#define TT_DEFAULT_SIZE_MB 64 ///< Taille de la table utilisée par le jeu
+
+/**
+ * @brief Nature du score enregistré dans une entrée.
+ */
+typedef enum {
+  BoundExact, ///< Score exact
+  BoundLower, ///< Le score réel est au moins celui-ci (coupure beta)
+  BoundUpper  ///< Le score réel est au plus celui-ci (aucun coup > alpha)
+} TTBound;
+
+/**
+ * @brief Contenu d'une entrée de la table, une fois décodé.
+ */
+typedef struct {
+  int score;     ///< Score du point de vue du joueur dont c'est le tour
+  uint8_t depth; ///< Profondeur restante de la recherche enregistrée
+  TTBound bound; ///< Nature du score
+  bool has_move; ///< `false` si aucun coup n'a été retenu
+  Move move;     ///< Meilleur coup trouvé
+} TTData;
+
+/**
+ * @brief Entrée de la table : deux mots de 64 bits.
+ *
+ * `check` vaut `key ^ data`. Deux threads peuvent écrire la même entrée en
+ * même temps sans verrou : une entrée mélangeant deux écritures ne vérifie
+ * plus l'égalité et est simplement ignorée à la lecture.
+ */
+typedef struct {
+  uint64_t check; ///< Clé de la position XOR `data`
+  uint64_t data;  ///< Score, profondeur, borne et coup compactés
+} TTEntry;
+
+/**
+ * @brief Table de transposition partagée par les threads de recherche.
+ *
+ * Indexée par la clé de Zobrist de `GameState` (`hash`), avec une entrée par
+ * emplacement. Aucune fonction ne prend de verrou.
+ */
+typedef struct {
+  TTEntry *entries; ///< Tableau de `mask + 1` entrées
+  uint64_t mask;    ///< Nombre d'entrées moins un (puissance de deux)
+} TranspositionTable;
+
+/**
+ * @brief Alloue une table vide.
+ *
+ * @param megabytes Taille maximale en mégaoctets, arrondie à la puissance de
+ * deux inférieure.
+ * @return TranspositionTable La table allouée.
+ */
+TranspositionTable init_tt(size_t megabytes);
+
+/**
+ * @brief Libère la mémoire d'une table.
+ *
+ * @param tt Pointeur vers la table à libérer.
+ */
+void free_tt(TranspositionTable *tt);
+
+/**
+ * @brief Vide toutes les entrées d'une table.
+ *
+ * @param tt Pointeur vers la table à vider.
+ */
+void clear_tt(TranspositionTable *tt);
+
+/**
+ * @brief Cherche une position dans la table.
+ *
+ * @param tt Pointeur vers la table.
+ * @param key La clé de la position.
+ * @param out Reçoit l'entrée décodée si elle est trouvée.
+ * @return bool `true` si une entrée valide correspond à la clé.
+ */
+bool tt_probe(const TranspositionTable *tt, uint64_t key, TTData *out);
+
+/**
+ * @brief Enregistre le résultat de la recherche d'une position.
+ *
+ * Une entrée d'une autre position est toujours remplacée ; une entrée de la
+ * même position ne l'est que par une recherche au moins aussi profonde.
+ *
+ * @param tt Pointeur vers la table.
+ * @param key La clé de la position.
+ * @param entry Le résultat à enregistrer.
+ */
+void tt_store(TranspositionTable *tt, uint64_t key, TTData entry);
+
+#endif // TT_H
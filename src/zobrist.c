@@ -0,0 +1,78 @@
+#include "zobrist.h"
+
+uint64_t zobrist_piece_keys[2][6][ZOBRIST_SQUARES];
+uint64_t zobrist_owner_keys[2][ZOBRIST_SQUARES];
+uint64_t zobrist_counter_keys[2][6][ZOBRIST_MAX_COUNT + 1];
+uint64_t zobrist_mode_keys[2];
+uint64_t zobrist_dim_keys[BITBOARD_MAX_DIM + 1];
+uint64_t zobrist_opponent_turn_key;
+
+static bool zobrist_keys_ready = false;
+
+// Générateur splitmix64 : rapide, et de bonne qualité pour des clés
+static uint64_t splitmix64(uint64_t *seed) {
+  uint64_t z = (*seed += 0x9E3779B97F4A7C15ULL);
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+  return z ^ (z >> 31);
+}
+
+void init_zobrist_keys(void) {
+  if (zobrist_keys_ready)
+    return;
+
+  uint64_t seed = 0x50524F4A49463242ULL; // "PROJIF2B"
+
+  for (int p = 0; p < 2; ++p) {
+    for (int k = 0; k < 6; ++k) {
+      for (int sq = 0; sq < ZOBRIST_SQUARES; ++sq)
+        zobrist_piece_keys[p][k][sq] = splitmix64(&seed);
+      for (int c = 0; c <= ZOBRIST_MAX_COUNT; ++c)
+        zobrist_counter_keys[p][k][c] = splitmix64(&seed);
+    }
+    for (int sq = 0; sq < ZOBRIST_SQUARES; ++sq)
+      zobrist_owner_keys[p][sq] = splitmix64(&seed);
+    zobrist_mode_keys[p] = splitmix64(&seed);
+  }
+
+  for (int d = 0; d <= BITBOARD_MAX_DIM; ++d)
+    zobrist_dim_keys[d] = splitmix64(&seed);
+  zobrist_opponent_turn_key = splitmix64(&seed);
+
+  zobrist_keys_ready = true;
+}
+
+uint64_t hash_piece_counter(const Player player,
+                            const PieceCountTracker *counter) {
+  uint64_t hash = 0;
+
+  for (int kind = King; kind <= Pawn; ++kind)
+    hash ^= zobrist_counter_key(player, kind,
+                                get_piece_count(counter, (PieceKind)kind));
+
+  return hash;
+}
+
+uint64_t compute_hash(const GameState *state) {
+  const Board *board = &state->board;
+  uint64_t hash = zobrist_mode_keys[state->mode == Conquest ? 0 : 1] ^
+                  zobrist_dim_keys[board->dim];
+
+  if (state->is_turn_of == Opponent)
+    hash ^= zobrist_opponent_turn_key;
+
+  for (uint8_t y = 0; y < board->dim; ++y) {
+    for (uint8_t x = 0; x < board->dim; ++x) {
+      const Tile tile = board->tiles[y][x];
+      if (tile.some)
+        hash ^= zobrist_piece_key(tile.value.player, tile.value.kind, x, y);
+      if (tile.captured_by.some)
+        hash ^= zobrist_owner_key(tile.captured_by.player, x, y);
+    }
+  }
+
+  hash ^= hash_piece_counter(User, &state->piece_counter_1);
+  hash ^= hash_piece_counter(Opponent, &state->piece_counter_2);
+
+  return hash;
+}
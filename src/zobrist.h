@@ -0,0 +1,70 @@
+#ifndef ZOBRIST_H
+#define ZOBRIST_H
+#include "game_state.h"
+#include <stdint.h>
+
+#define ZOBRIST_SQUARES (BITBOARD_MAX_DIM * BITBOARD_MAX_DIM)
+#define ZOBRIST_MAX_COUNT 8 ///< Plus grand nombre de pièces d'un même type
+
+/**
+ * @brief Clés aléatoires de 64 bits utilisées pour le hachage de Zobrist.
+ *
+ * Les cases sont indexées par `y * 12 + x`. Les clés sont générées par
+ * `init_zobrist_keys` à partir d'une graine fixe : une même position a donc la
+ * même clé d'une exécution à l'autre (utile pour les fichiers de positions).
+ */
+extern uint64_t zobrist_piece_keys[2][6][ZOBRIST_SQUARES];
+extern uint64_t zobrist_owner_keys[2][ZOBRIST_SQUARES];
+extern uint64_t zobrist_counter_keys[2][6][ZOBRIST_MAX_COUNT + 1];
+extern uint64_t zobrist_mode_keys[2];
+extern uint64_t zobrist_dim_keys[BITBOARD_MAX_DIM + 1];
+extern uint64_t zobrist_opponent_turn_key;
+
+/**
+ * @brief Génère les clés de Zobrist. Les appels suivants ne font rien.
+ */
+void init_zobrist_keys(void);
+
+/// Clé d'une pièce `kind` du joueur `player` posée en (x, y).
+static inline uint64_t zobrist_piece_key(const Player player,
+                                         const PieceKind kind, const uint8_t x,
+                                         const uint8_t y) {
+  return zobrist_piece_keys[player][kind][y * BITBOARD_MAX_DIM + x];
+}
+
+/// Clé d'une case (x, y) capturée par `player`.
+static inline uint64_t zobrist_owner_key(const Player player, const uint8_t x,
+                                         const uint8_t y) {
+  return zobrist_owner_keys[player][y * BITBOARD_MAX_DIM + x];
+}
+
+/// Clé indiquant qu'il reste `count` pièces `kind` au joueur `player`.
+static inline uint64_t zobrist_counter_key(const Player player,
+                                           const PieceKind kind,
+                                           const uint8_t count) {
+  return zobrist_counter_keys[player][kind][count];
+}
+
+/**
+ * @brief Contribution d'un compteur de pièces disponibles à la clé.
+ *
+ * @param player Le joueur auquel appartient le compteur.
+ * @param counter Le compteur de pièces.
+ * @return uint64_t Le XOR des clés des six types de pièces.
+ */
+uint64_t hash_piece_counter(Player player, const PieceCountTracker *counter);
+
+/**
+ * @brief Calcule entièrement la clé de Zobrist d'un état de jeu.
+ *
+ * Couvre les pièces posées, le propriétaire de chaque case, le joueur à qui
+ * c'est le tour, le mode, la dimension et les deux compteurs de pièces. Le
+ * champ `hash` de `GameState` est tenu à jour de façon incrémentale ; cette
+ * fonction sert à l'initialiser et à le vérifier.
+ *
+ * @param state Pointeur vers l'état de jeu.
+ * @return uint64_t La clé de la position.
+ */
+uint64_t compute_hash(const GameState *state);
+
+#endif // ZOBRIST_H